@@ -0,0 +1,177 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "container/clist.h"
+#include "container/list.h"
+
+#define KEYS 1024
+
+////////////////////////////////////////////////////////////////////////////
+// Helpers
+////////////////////////////////////////////////////////////////////////////
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+static int compare_key(const void* data1, const void* data2) { return *(const int*)data1 != *(const int*)data2; }
+static int* new_key(int key) {
+  int* data = (int*)malloc(sizeof(int));
+  if (data) *data = key;
+  return data;
+}
+
+typedef enum { KIND_CLIST, KIND_MUTEX, KIND_RWLOCK } kind_t;
+
+typedef struct bench_t {
+  kind_t kind;
+  int reads;  // Percentage of finds, the rest is split between inserts and erases
+  size_t ops;
+  clist_t* clst;
+  list_t lst;  // Shared behind one lock, as done without clist
+  pthread_mutex_t mutex;
+  pthread_rwlock_t rwlock;
+} bench_t;
+
+typedef struct worker_t {
+  bench_t* bench;
+  unsigned seed;
+} worker_t;
+
+static void find(bench_t* b, int key) {
+  if (b->kind == KIND_CLIST) {
+    clist_find(b->clst, &key, compare_key, NULL, NULL);
+  } else if (b->kind == KIND_MUTEX) {
+    pthread_mutex_lock(&b->mutex);
+    lst_cfind(&b->lst, &key, compare_key);
+    pthread_mutex_unlock(&b->mutex);
+  } else {
+    pthread_rwlock_rdlock(&b->rwlock);
+    lst_cfind(&b->lst, &key, compare_key);
+    pthread_rwlock_unlock(&b->rwlock);
+  }
+}
+static void insert(bench_t* b, int key) {
+  int* data = new_key(key);
+  if (b->kind == KIND_CLIST) {
+    // Keeps insert positions spread over the list
+    clist_insert_before(b->clst, data, compare_key, data);
+    return;
+  }
+  if (b->kind == KIND_MUTEX)
+    pthread_mutex_lock(&b->mutex);
+  else
+    pthread_rwlock_wrlock(&b->rwlock);
+  lst_push_back(&b->lst, data);
+  if (b->kind == KIND_MUTEX)
+    pthread_mutex_unlock(&b->mutex);
+  else
+    pthread_rwlock_unlock(&b->rwlock);
+}
+static void erase(bench_t* b, int key) {
+  if (b->kind == KIND_CLIST) {
+    clist_erase(b->clst, &key, compare_key, NULL);
+    return;
+  }
+  if (b->kind == KIND_MUTEX)
+    pthread_mutex_lock(&b->mutex);
+  else
+    pthread_rwlock_wrlock(&b->rwlock);
+  lst_erase_if(&b->lst, &key, compare_key, NULL);
+  if (b->kind == KIND_MUTEX)
+    pthread_mutex_unlock(&b->mutex);
+  else
+    pthread_rwlock_unlock(&b->rwlock);
+}
+static void* worker(void* arg) {
+  worker_t* w = (worker_t*)arg;
+  bench_t* b = w->bench;
+  size_t i = 0;
+  for (i = 0; i < b->ops; i++) {
+    int key = rand_r(&w->seed) % KEYS;
+    int op = rand_r(&w->seed) % 100;
+    if (op < b->reads)
+      find(b, key);
+    else if ((op - b->reads) % 2)
+      insert(b, key);
+    else
+      erase(b, key);
+  }
+  return NULL;
+}
+static void run(kind_t kind, const char* name, int reads, size_t threads, size_t ops) {
+  bench_t b;
+  pthread_t ids[64];
+  worker_t workers[64];
+  size_t i = 0;
+
+  b.kind = kind;
+  b.reads = reads;
+  b.ops = ops;
+  b.clst = clist_create();
+  lst_init(&b.lst);
+  pthread_mutex_init(&b.mutex, NULL);
+  pthread_rwlock_init(&b.rwlock, NULL);
+  if (!b.clst) exit(1);
+  // Half of the keys present
+  for (i = 0; i < KEYS; i += 2) {
+    clist_push_back(b.clst, new_key((int)i));
+    lst_push_back(&b.lst, new_key((int)i));
+  }
+
+  double t0 = now_ns();
+  for (i = 0; i < threads; i++) {
+    workers[i].bench = &b;
+    workers[i].seed = (unsigned)i + 1;
+    pthread_create(&ids[i], NULL, worker, &workers[i]);
+  }
+  for (i = 0; i < threads; i++) pthread_join(ids[i], NULL);
+  double elapsed = now_ns() - t0;
+  printf("%-8s %3d%% reads %2zu threads %10.0f ops/s\n", name, reads, threads,
+         (double)(threads * ops) / elapsed * 1e9);
+
+  clist_destroy(b.clst, NULL);
+  lst_clear(&b.lst, NULL);
+  pthread_mutex_destroy(&b.mutex);
+  pthread_rwlock_destroy(&b.rwlock);
+}
+////////////////////////////////////////////////////////////////////////////
+// Mixed find/insert/erase workloads on one shared list
+////////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv) {
+  size_t ops = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : 20000;
+  int reads[] = {100, 90, 50};
+  size_t r = 0, threads = 0;
+
+  for (r = 0; r < sizeof(reads) / sizeof(reads[0]); r++) {
+    for (threads = 1; threads <= 8; threads *= 2) {
+      run(KIND_CLIST, "clist", reads[r], threads, ops);
+      run(KIND_MUTEX, "mutex", reads[r], threads, ops);
+      run(KIND_RWLOCK, "rwlock", reads[r], threads, ops);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,105 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "container/deque.h"
+#include "container/list.h"
+
+// list_push_back walks the queue, the bare list is measured up to this depth
+#define LIST_MAX_DEPTH 1024
+#define BATCH 64
+
+////////////////////////////////////////////////////////////////////////////
+// Helpers
+////////////////////////////////////////////////////////////////////////////
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+// Elements point into a static array and are not freed
+static void keep(void* data) { (void)data; }
+////////////////////////////////////////////////////////////////////////////
+// FIFO at a steady depth: push at the back and pop at the front, one at a time and in batches
+////////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv) {
+  static char values[BATCH];
+  size_t ops = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : 1000000;
+  size_t depth = 0, i = 0, j = 0;
+  void* batch[BATCH];
+  for (i = 0; i < BATCH; i++) batch[i] = &values[i];
+
+  for (depth = 16; depth <= 65536; depth *= 64) {
+    double bare = 0;
+    if (depth <= LIST_MAX_DEPTH) {
+      dlist_t* lst = NULL;
+      for (i = 0; i < depth; i++) list_push_back(&lst, &values[i % BATCH]);
+      double t0 = now_ns();
+      for (i = 0; i < ops; i++) {
+        list_push_back(&lst, &values[i % BATCH]);
+        list_pop_front(&lst, keep);
+      }
+      bare = (now_ns() - t0) / ops;
+      list_clear(&lst, keep);
+    }
+
+    list_t lst;
+    lst_init(&lst);
+    for (i = 0; i < depth; i++) lst_push_back(&lst, &values[i % BATCH]);
+    double t0 = now_ns();
+    for (i = 0; i < ops; i++) {
+      lst_push_back(&lst, &values[i % BATCH]);
+      lst_pop_front(&lst, keep);
+    }
+    double t1 = now_ns();
+    lst_clear(&lst, keep);
+
+    deque_t dq;
+    deque_init(&dq);
+    for (i = 0; i < depth; i++) deque_push_back(&dq, &values[i % BATCH]);
+    double t2 = now_ns();
+    for (i = 0; i < ops; i++) {
+      deque_push_back(&dq, &values[i % BATCH]);
+      deque_pop_front(&dq, keep);
+    }
+    double t3 = now_ns();
+    void* out[BATCH];
+    for (i = 0; i < ops; i += BATCH) {
+      deque_push_n(&dq, batch, BATCH);
+      j += deque_pop_n(&dq, out, BATCH);
+    }
+    double t4 = now_ns();
+    int valid = deque_size(&dq) == depth && j >= ops;
+    j = 0;
+    deque_destroy(&dq, keep);
+
+    if (depth <= LIST_MAX_DEPTH)
+      printf("depth=%-6zu dlist_t %8.1f ns/op", depth, bare);
+    else
+      printf("depth=%-6zu dlist_t %8s ns/op", depth, "-");
+    printf("  list_t %6.1f ns/op  deque %6.1f ns/op  deque batch %6.2f ns/op%s\n", (t1 - t0) / ops, (t3 - t2) / ops,
+           (t4 - t3) / ops, valid ? "" : "  MISMATCH");
+  }
+  return 0;
+}
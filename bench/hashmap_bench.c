@@ -0,0 +1,116 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "container/hashmap.h"
+#include "container/list.h"
+
+// The list store does a linear scan per operation, it is measured up to this size
+#define LIST_MAX_COUNT 10000
+
+typedef struct entry_t {
+  uint64_t key;
+  uint64_t value;
+} entry_t;
+
+////////////////////////////////////////////////////////////////////////////
+// Helpers
+////////////////////////////////////////////////////////////////////////////
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+static size_t hash_entry(const void* data) { return (size_t)((const entry_t*)data)->key; }
+static int compare_entry(const void* data1, const void* data2) {
+  return ((const entry_t*)data1)->key != ((const entry_t*)data2)->key;
+}
+static void copy_entry(const void* src_data, void* dst_data) { memcpy(dst_data, src_data, sizeof(entry_t)); }
+static void* ctor_entry(const void* src_data) {
+  entry_t* entry = (entry_t*)malloc(sizeof(entry_t));
+  if (entry) memcpy(entry, src_data, sizeof(entry_t));
+  return entry;
+}
+static int compare_double(const void* data1, const void* data2) {
+  double value1 = *(const double*)data1, value2 = *(const double*)data2;
+  return (value1 > value2) - (value1 < value2);
+}
+////////////////////////////////////////////////////////////////////////////
+// Key-value store: list_push_back_unique and list_find against hashmap_put and hashmap_find, with the per-insert
+// latency tail of the hash map across its incremental resizes
+////////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv) {
+  size_t max_count = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : 1000000;
+  entry_t* entries = (entry_t*)calloc(max_count, sizeof(entry_t));
+  double* latencies = (double*)calloc(max_count, sizeof(double));
+  if (!entries || !latencies) return 1;
+
+  size_t count = 0, i = 0;
+  srand(1);
+  for (i = 0; i < max_count; i++) {
+    entries[i].key = ((uint64_t)rand() << 31) ^ (uint64_t)rand() ^ ((uint64_t)i << 48);
+    entries[i].value = i;
+  }
+  for (count = 1000; count <= max_count; count *= 10) {
+    double list_put_ns = 0, list_find_ns = 0;
+    int found = 1;
+    if (count <= LIST_MAX_COUNT) {
+      dlist_t* lst = NULL;
+      double t0 = now_ns();
+      for (i = 0; i < count; i++)
+        list_push_back_unique(&lst, &entries[i], &entries[i], compare_entry, copy_entry, ctor_entry);
+      double t1 = now_ns();
+      for (i = 0; i < count; i++) found &= list_find(lst, &entries[i], compare_entry) != NULL;
+      double t2 = now_ns();
+      list_clear(&lst, NULL);
+      list_put_ns = (t1 - t0) / count;
+      list_find_ns = (t2 - t1) / count;
+    }
+
+    hashmap_t* map = hashmap_create(hash_entry, compare_entry);
+    double t0 = now_ns();
+    for (i = 0; i < count; i++) {
+      double t = now_ns();
+      hashmap_put(map, ctor_entry(&entries[i]), NULL);
+      latencies[i] = now_ns() - t;
+    }
+    double t1 = now_ns();
+    for (i = 0; i < count; i++) found &= hashmap_find(map, &entries[i]) != NULL;
+    double t2 = now_ns();
+    hashmap_destroy(map, NULL);
+    qsort(latencies, count, sizeof(double), compare_double);
+
+    if (count <= LIST_MAX_COUNT)
+      printf("n=%-9zu list put %10.1f ns  find %10.1f ns | ", count, list_put_ns, list_find_ns);
+    else
+      printf("n=%-9zu list put %10s ns  find %10s ns | ", count, "-", "-");
+    printf("hashmap put %6.1f ns  find %6.1f ns  put p99 %6.0f ns  max %8.0f ns%s\n", (t1 - t0) / count,
+           (t2 - t1) / count, latencies[count * 99 / 100], latencies[count - 1], found ? "" : "  MISMATCH");
+  }
+  free(latencies);
+  free(entries);
+  return 0;
+}
@@ -0,0 +1,195 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "container/lfqueue.h"
+#include "container/list.h"
+
+////////////////////////////////////////////////////////////////////////////
+// Helpers
+////////////////////////////////////////////////////////////////////////////
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+static void no_delete(void* data) { (void)data; }
+
+// Element carries the time it was pushed, the consumer measures the time it spent in the queue. Every run checks that
+// each element was popped exactly once
+typedef struct item_t {
+  double pushed;
+  atomic_int pops;
+} item_t;
+
+typedef enum { KIND_LFQUEUE, KIND_DLIST, KIND_LIST } kind_t;
+
+typedef struct bench_t {
+  kind_t kind;
+  size_t per_producer;
+  size_t total;
+  atomic_size_t consumed;
+  lfqueue_t* queue;
+  pthread_mutex_t lock;  // Wraps the list variants
+  dlist_t* dlist;
+  list_t list;
+  item_t* items;
+  double latency[64];  // Sum of queue latencies per consumer
+  double max_latency[64];
+} bench_t;
+
+typedef struct worker_t {
+  bench_t* bench;
+  size_t id;
+} worker_t;
+
+static void push(bench_t* b, lfqueue_handle_t* handle, item_t* item) {
+  item->pushed = now_ns();
+  if (b->kind == KIND_LFQUEUE) {
+    lfqueue_push(handle, item);
+    return;
+  }
+  pthread_mutex_lock(&b->lock);
+  if (b->kind == KIND_DLIST)
+    list_push_back(&b->dlist, item);
+  else
+    lst_push_back(&b->list, item);
+  pthread_mutex_unlock(&b->lock);
+}
+static item_t* pop(bench_t* b, lfqueue_handle_t* handle) {
+  item_t* item = NULL;
+  if (b->kind == KIND_LFQUEUE) return (item_t*)lfqueue_pop(handle);
+  pthread_mutex_lock(&b->lock);
+  if (b->kind == KIND_DLIST) {
+    if (b->dlist) {
+      item = (item_t*)b->dlist->data;
+      list_pop_front(&b->dlist, no_delete);
+    }
+  } else if (!lst_empty(&b->list)) {
+    item = (item_t*)lst_front(&b->list)->data;
+    lst_pop_front(&b->list, no_delete);
+  }
+  pthread_mutex_unlock(&b->lock);
+  return item;
+}
+static void* producer(void* arg) {
+  worker_t* w = (worker_t*)arg;
+  bench_t* b = w->bench;
+  lfqueue_handle_t* handle = b->kind == KIND_LFQUEUE ? lfqueue_acquire(b->queue) : NULL;
+  item_t* items = b->items + w->id * b->per_producer;
+  size_t i = 0;
+  for (i = 0; i < b->per_producer; i++) push(b, handle, &items[i]);
+  lfqueue_release(handle);
+  return NULL;
+}
+static void* consumer(void* arg) {
+  worker_t* w = (worker_t*)arg;
+  bench_t* b = w->bench;
+  lfqueue_handle_t* handle = b->kind == KIND_LFQUEUE ? lfqueue_acquire(b->queue) : NULL;
+  double sum = 0, max = 0;
+  while (atomic_load(&b->consumed) < b->total) {
+    item_t* item = pop(b, handle);
+    if (!item) continue;
+    atomic_fetch_add(&item->pops, 1);
+    double latency = now_ns() - item->pushed;
+    sum += latency;
+    if (latency > max) max = latency;
+    atomic_fetch_add(&b->consumed, 1);
+  }
+  b->latency[w->id] = sum;
+  b->max_latency[w->id] = max;
+  lfqueue_release(handle);
+  return NULL;
+}
+static void run(kind_t kind, const char* name, size_t pairs, size_t per_producer) {
+  bench_t b;
+  pthread_t threads[128];
+  worker_t workers[128];
+  size_t i = 0;
+
+  b.kind = kind;
+  b.per_producer = per_producer;
+  b.total = pairs * per_producer;
+  atomic_init(&b.consumed, 0);
+  b.queue = lfqueue_create();
+  pthread_mutex_init(&b.lock, NULL);
+  b.dlist = NULL;
+  lst_init(&b.list);
+  b.items = (item_t*)calloc(b.total, sizeof(item_t));
+  if (!b.queue || !b.items) exit(1);
+  for (i = 0; i < b.total; i++) atomic_init(&b.items[i].pops, 0);
+
+  double t0 = now_ns();
+  for (i = 0; i < pairs; i++) {
+    workers[i].bench = &b;
+    workers[i].id = i;
+    pthread_create(&threads[i], NULL, consumer, &workers[i]);
+  }
+  for (i = 0; i < pairs; i++) {
+    workers[pairs + i].bench = &b;
+    workers[pairs + i].id = i;
+    pthread_create(&threads[pairs + i], NULL, producer, &workers[pairs + i]);
+  }
+  for (i = 0; i < 2 * pairs; i++) pthread_join(threads[i], NULL);
+  double elapsed = now_ns() - t0;
+
+  for (i = 0; i < b.total; i++) {
+    int pops = atomic_load(&b.items[i].pops);
+    if (pops != 1) {
+      fprintf(stderr, "%s %zu/%zu: element %zu popped %d times\n", name, pairs, pairs, i, pops);
+      exit(1);
+    }
+  }
+
+  double latency = 0, max = 0;
+  for (i = 0; i < pairs; i++) {
+    latency += b.latency[i];
+    if (b.max_latency[i] > max) max = b.max_latency[i];
+  }
+  printf("%-8s %2zu/%-2zu %8.2f Mops/s  latency avg %10.0f ns  max %12.0f ns\n", name, pairs, pairs,
+         (double)b.total / elapsed * 1e3, latency / (double)b.total, max);
+
+  lfqueue_destroy(b.queue, no_delete);
+  pthread_mutex_destroy(&b.lock);
+  list_clear(&b.dlist, no_delete);
+  lst_clear(&b.list, no_delete);
+  free(b.items);
+}
+////////////////////////////////////////////////////////////////////////////
+// Producers/consumers through the lock-free queue and mutex-wrapped lists
+////////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv) {
+  size_t per_producer = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : 200000;
+  size_t pairs = 0;
+
+  printf("%-8s %5s %15s\n", "queue", "P/C", "throughput");
+  for (pairs = 1; pairs <= 8; pairs *= 2) {
+    run(KIND_LFQUEUE, "lfqueue", pairs, per_producer);
+    run(KIND_DLIST, "dlist_t", pairs, per_producer);
+    run(KIND_LIST, "list_t", pairs, per_producer);
+  }
+  return 0;
+}
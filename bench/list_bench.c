@@ -0,0 +1,225 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <time.h>
+
+#include "container/arena.h"
+#include "container/list.h"
+
+////////////////////////////////////////////////////////////////////////////
+// Helpers
+////////////////////////////////////////////////////////////////////////////
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+////////////////////////////////////////////////////////////////////////////
+// Node allocation: calloc/free against arena
+////////////////////////////////////////////////////////////////////////////
+// Builds and drops a list of 'count' elements 'rounds' times, payloads are not owned by the list
+static void bench_alloc(const char* name, const list_allocator_t* allocator, int* values, size_t count,
+                        size_t rounds) {
+  list_t lst;
+  lst_init_allocator(&lst, allocator);
+
+  double push = 0, clear = 0;
+  size_t r = 0, i = 0;
+  for (r = 0; r < rounds; r++) {
+    double t0 = now_ns();
+    for (i = 0; i < count; i++) lst_push_back(&lst, &values[i]);
+    double t1 = now_ns();
+    lst_reset(&lst);
+    double t2 = now_ns();
+    push += t1 - t0;
+    clear += t2 - t1;
+  }
+  printf("%-8s n=%-9zu push_back %7.2f ns/op  clear %10.0f ns\n", name, count, push / (double)(count * rounds),
+         clear / (double)rounds);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Callbacks: varargs against context pointer
+////////////////////////////////////////////////////////////////////////////
+typedef struct sum_ctx_t {
+  long* sum;
+  int* scale;
+} sum_ctx_t;
+static int add_extra(void* data, long* sum, int* scale) {
+  *sum += *(int*)data * *scale;
+  return 0;
+}
+static int add_ctx(void* data, void* ctx) {
+  sum_ctx_t* sum_ctx = (sum_ctx_t*)ctx;
+  *sum_ctx->sum += *(int*)data * *sum_ctx->scale;
+  return 0;
+}
+static void bench_callbacks(int* values, size_t count, size_t rounds) {
+  list_t lst;
+  lst_init(&lst);
+  size_t r = 0, i = 0;
+  for (i = 0; i < count; i++) lst_push_back(&lst, &values[i]);
+
+  long sum = 0;
+  int scale = 2;
+  sum_ctx_t ctx = {&sum, &scale};
+  double t0 = now_ns();
+  for (r = 0; r < rounds; r++)
+    list_for_each_extra(lst.head, (int (*)(void*))(void (*)(void))add_extra, 2, &sum, &scale);
+  double t1 = now_ns();
+  for (r = 0; r < rounds; r++) list_for_each_ctx(lst.head, add_ctx, &ctx);
+  double t2 = now_ns();
+  printf("%-8s n=%-9zu for_each_extra %6.2f ns/elem  for_each_ctx %6.2f ns/elem\n", "callback", count,
+         (t1 - t0) / (double)(count * rounds), (t2 - t1) / (double)(count * rounds));
+  lst_reset(&lst);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Serialization: growing functor against sized buffer and scatter/gather
+////////////////////////////////////////////////////////////////////////////
+#define PAYLOAD_SZ 256
+static const void* view_payload(const void* data, size_t* size) {
+  *size = PAYLOAD_SZ;
+  return data;
+}
+static uint8_t* adapt_payload(void* data) { return (uint8_t*)data; }
+// Appends one record the way callers of transform_lst_to_data_x do, growing the buffer with realloc
+static uint8_t* append_record(uint8_t** data, size_t* data_sz, size_t number_elements, ...) {
+  va_list vl;
+  va_start(vl, number_elements);
+  const uint8_t* bytes = va_arg(vl, const uint8_t*);
+  va_end(vl);
+  uint8_t* buf = (uint8_t*)realloc(*data, *data_sz + sizeof(uint64_t) + PAYLOAD_SZ);
+  if (!buf) return NULL;
+  uint64_t size = PAYLOAD_SZ;
+  memcpy(buf + *data_sz, &size, sizeof(size));
+  memcpy(buf + *data_sz + sizeof(size), bytes, PAYLOAD_SZ);
+  *data = buf;
+  *data_sz += sizeof(uint64_t) + PAYLOAD_SZ;
+  return buf;
+}
+static void bench_serialize(uint8_t* payloads, size_t count, size_t rounds) {
+  list_t lst;
+  lst_init(&lst);
+  size_t r = 0, i = 0;
+  for (i = 0; i < count; i++) lst_push_back(&lst, payloads + i * PAYLOAD_SZ);
+
+  double functor = 0, buffer = 0, iovec = 0;
+  for (r = 0; r < rounds; r++) {
+    uint8_t* data = NULL;
+    size_t data_sz = 0;
+    double t0 = now_ns();
+    transform_lst_to_data_x(lst.head, &data, &data_sz, append_record, 1, (void*)adapt_payload);
+    double t1 = now_ns();
+    free(data);
+    data = NULL;
+    double t2 = now_ns();
+    transform_lst_to_buffer(lst.head, &data, &data_sz, view_payload);
+    double t3 = now_ns();
+    free(data);
+    size_t iov_count = 0;
+    double t4 = now_ns();
+    struct iovec* iov = transform_lst_to_iovec(lst.head, &iov_count, view_payload);
+    double t5 = now_ns();
+    free(iov);
+    functor += t1 - t0;
+    buffer += t3 - t2;
+    iovec += t5 - t4;
+  }
+  printf("%-8s n=%-9zu functor %7.2f ns/elem  buffer %7.2f ns/elem  iovec %7.2f ns/elem\n", "serial", count,
+         functor / (double)(count * rounds), buffer / (double)(count * rounds), iovec / (double)(count * rounds));
+  lst_reset(&lst);
+}
+
+////////////////////////////////////////////////////////////////////////////
+// LRU touch: moving a held node to the front against removing and re-inserting it by value
+////////////////////////////////////////////////////////////////////////////
+// The values are all zero, elements are told apart by address
+static int compare_ptr(const void* data1, const void* data2) { return data1 != data2; }
+static void no_delete(void* data) { (void)data; }
+static void bench_touch(int* values, size_t count, size_t touches) {
+  list_t lst;
+  lst_init(&lst);
+  dlist_t** nodes = (dlist_t**)malloc(count * sizeof(dlist_t*));
+  dlist_t* bare = NULL;
+  if (!nodes) return;
+  size_t i = 0;
+  for (i = 0; i < count; i++) nodes[i] = lst_push_back(&lst, &values[i]);
+  for (i = 0; i < count; i++) list_insert_after(&bare, NULL, &values[count - 1 - i]);
+
+  uint32_t state = 1;
+  double t0 = now_ns();
+  for (i = 0; i < touches; i++) {
+    state = state * 1664525u + 1013904223u;
+    lst_move_to_front(&lst, nodes[state % count]);
+  }
+  double t1 = now_ns();
+  for (i = 0; i < touches; i++) {
+    state = state * 1664525u + 1013904223u;
+    int* value = &values[state % count];
+    list_remove_if(&bare, value, compare_ptr, no_delete);
+    list_insert_after(&bare, NULL, value);
+  }
+  double t2 = now_ns();
+  printf("%-8s n=%-9zu move_to_front %8.2f ns/op  remove_if+insert %12.2f ns/op\n", "touch", count,
+         (t1 - t0) / (double)touches, (t2 - t1) / (double)touches);
+  lst_reset(&lst);
+  list_clear(&bare, no_delete);
+  free(nodes);
+}
+
+int main(void) {
+  const size_t max_count = 10000000;
+  int* values = (int*)calloc(max_count, sizeof(int));
+  if (!values) return 1;
+
+  size_t count = 0;
+  for (count = 1000; count <= max_count; count *= 10) {
+    size_t rounds = max_count / count > 100 ? 100 : max_count / count;
+
+    bench_alloc("calloc", NULL, values, count, rounds);
+
+    arena_t arena;
+    list_allocator_t allocator;
+    arena_init(&arena, sizeof(dlist_t), 4096);
+    arena_list_allocator(&arena, &allocator);
+    bench_alloc("arena", &allocator, values, count, rounds);
+    arena_destroy(&arena);
+
+    bench_callbacks(values, count, rounds);
+
+    bench_touch(values, count, count >= 1000000 ? 10 : 1000);
+
+    // Payload copies stay under 300 MB
+    if (count <= 1000000) {
+      uint8_t* payloads = (uint8_t*)calloc(count, PAYLOAD_SZ);
+      if (payloads) bench_serialize(payloads, count, rounds > 10 ? 10 : rounds);
+      free(payloads);
+    }
+  }
+  free(values);
+  return 0;
+}
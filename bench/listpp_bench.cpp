@@ -0,0 +1,120 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <time.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+
+#include "container/list.hpp"
+
+////////////////////////////////////////////////////////////////////////////
+// Helpers
+////////////////////////////////////////////////////////////////////////////
+static double now_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+static int compare_i64(const void* data1, const void* data2) {
+  return *static_cast<const int64_t*>(data1) != *static_cast<const int64_t*>(data2);
+}
+static int less_i64(const void* data1, const void* data2) {
+  int64_t value1 = *static_cast<const int64_t*>(data1), value2 = *static_cast<const int64_t*>(data2);
+  return (value1 > value2) - (value1 < value2);
+}
+struct timings {
+  double push, count, sort, clear;
+  size_t found;
+};
+template <class List>
+static timings run_cpp(size_t count, bool sort) {
+  timings t = {};
+  int64_t key = 7;
+  srand(1);
+  List lst;
+  double t0 = now_ns();
+  for (size_t i = 0; i < count; i++) lst.emplace_back(rand() % 1000);
+  double t1 = now_ns();
+  for (const int64_t& value : lst) t.found += value == key;
+  double t2 = now_ns();
+  if (sort) lst.sort([](int64_t a, int64_t b) { return a < b; });
+  double t3 = now_ns();
+  lst.clear();
+  double t4 = now_ns();
+  t.push = (t1 - t0) / count;
+  t.count = (t2 - t1) / count;
+  t.sort = (t3 - t2) / count;
+  t.clear = (t4 - t3) / count;
+  return t;
+}
+static timings run_c(size_t count, bool sort) {
+  timings t = {};
+  int64_t key = 7;
+  srand(1);
+  list_t lst;
+  lst_init(&lst);
+  double t0 = now_ns();
+  for (size_t i = 0; i < count; i++) {
+    int64_t* data = static_cast<int64_t*>(malloc(sizeof(int64_t)));
+    *data = rand() % 1000;
+    lst_push_back(&lst, data);
+  }
+  double t1 = now_ns();
+  t.found = (size_t)lst_count(&lst, &key, compare_i64);
+  double t2 = now_ns();
+  if (sort) lst_sort(&lst, less_i64);
+  double t3 = now_ns();
+  lst_clear(&lst, NULL);
+  double t4 = now_ns();
+  t.push = (t1 - t0) / count;
+  t.count = (t2 - t1) / count;
+  t.sort = (t3 - t2) / count;
+  t.clear = (t4 - t3) / count;
+  return t;
+}
+////////////////////////////////////////////////////////////////////////////
+// int64 payloads: clc::list against std::list and the C list_t with a separately allocated payload, in ns/elem
+////////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv) {
+  size_t max_count = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : 1000000;
+  // Sorted lists are freed in value order, which scatters the heap for whatever is allocated next, so the sort pass
+  // runs after the others
+  for (int pass = 0; pass < 2; pass++) {
+    for (size_t count = 1000; count <= max_count; count *= 10) {
+      timings clc_t = run_cpp<clc::list<int64_t>>(count, pass);
+      timings std_t = run_cpp<std::list<int64_t>>(count, pass);
+      timings c_t = run_c(count, pass);
+      const char* mismatch = clc_t.found == std_t.found && std_t.found == c_t.found ? "" : "  MISMATCH";
+      if (pass)
+        printf("n=%-9zu sort  clc::list %7.1f  std::list %7.1f  list_t %7.1f%s\n", count, clc_t.sort, std_t.sort,
+               c_t.sort, mismatch);
+      else
+        printf("n=%-9zu push/count/clear  clc::list %5.1f %5.2f %5.1f  std::list %5.1f %5.2f %5.1f  list_t %5.1f "
+               "%5.2f %5.1f%s\n",
+               count, clc_t.push, clc_t.count, clc_t.clear, std_t.push, std_t.count, std_t.clear, c_t.push, c_t.count,
+               c_t.clear, mismatch);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,93 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "container/list_par.h"
+
+////////////////////////////////////////////////////////////////////////////
+// Helpers
+////////////////////////////////////////////////////////////////////////////
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+// Stands for an expensive predicate (parsing, regex): a few hundred nanoseconds of hashing
+static uint32_t work(int value) {
+  uint32_t h = (uint32_t)value;
+  int i = 0;
+  for (i = 0; i < 200; i++) h = h * 2654435761u + 0x9e3779b9u;
+  return h;
+}
+static int visit(void* data) { return work(*(int*)data) == 0; }
+static int is_equal(const void* data1, const void* data2) {
+  return (work(*(const int*)data1) == 0) || *(const int*)data1 != *(const int*)data2;
+}
+////////////////////////////////////////////////////////////////////////////
+// Scaling across thread counts
+////////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv) {
+  size_t count = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : 500000;
+  int* values = (int*)calloc(count, sizeof(int));
+  void** data = (void**)calloc(count, sizeof(void*));
+  if (!values || !data) return 1;
+
+  size_t i = 0;
+  for (i = 0; i < count; i++) {
+    values[i] = (int)i;
+    data[i] = &values[i];
+  }
+  list_t lst;
+  lst_init(&lst);
+  if (lst_append_array(&lst, data, count)) return 1;
+  // Match near the end, so find has to run almost everything
+  const int value = (int)(count - count / 20);
+
+  size_t threads = 0;
+  double base = 0;
+  for (threads = 0; threads <= 32; threads = threads ? threads * 2 : 1) {
+    // Zero threads stands for the sequential algorithms
+    thread_pool_t* pool = threads ? thread_pool_create(threads) : NULL;
+    if (threads && !pool) return 1;
+
+    double t0 = now_ns();
+    list_par_for_each(pool, lst.head, visit);
+    double t1 = now_ns();
+    int found = list_par_count(pool, lst.head, &value, is_equal);
+    double t2 = now_ns();
+    dlist_t* node = list_par_find(pool, lst.head, &value, is_equal);
+    double t3 = now_ns();
+    if (found != 1 || !node || *(int*)node->data != value) return 1;
+
+    if (!threads) base = t1 - t0;
+    printf("threads=%-3zu for_each %8.2f ms (x%5.2f)  count %8.2f ms  find %8.2f ms\n", threads, (t1 - t0) / 1e6,
+           base / (t1 - t0), (t2 - t1) / 1e6, (t3 - t2) / 1e6);
+    thread_pool_destroy(pool);
+  }
+  lst_reset(&lst);
+  free(data);
+  free(values);
+  return 0;
+}
@@ -0,0 +1,133 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "container/list.h"
+#include "container/plist.h"
+
+////////////////////////////////////////////////////////////////////////////
+// Helpers
+////////////////////////////////////////////////////////////////////////////
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+static const void* view_u64(const void* data, size_t* size) {
+  *size = sizeof(uint64_t);
+  return data;
+}
+static int compare_u64(const void* data1, const void* data2) {
+  uint64_t value1 = 0, value2 = 0;
+  memcpy(&value1, data1, sizeof(value1));
+  memcpy(&value2, data2, sizeof(value2));
+  return value1 != value2;
+}
+static uint8_t* read_file(const char* path, size_t* size) {
+  FILE* file = fopen(path, "rb");
+  if (!file) return NULL;
+  fseek(file, 0, SEEK_END);
+  *size = (size_t)ftell(file);
+  fseek(file, 0, SEEK_SET);
+  uint8_t* data = (uint8_t*)malloc(*size ? *size : 1);
+  if (data && *size && fread(data, *size, 1, file) != 1) {
+    free(data);
+    data = NULL;
+  }
+  fclose(file);
+  return data;
+}
+////////////////////////////////////////////////////////////////////////////
+// Startup: rebuilding a list from a record stream, whole or in chunks, against mapping a list file
+////////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv) {
+  size_t max_count = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : 1000000;
+  const char* stream_path = "plist_bench.rec";
+  const char* plist_path = "plist_bench.plist";
+  uint64_t* values = (uint64_t*)calloc(max_count, sizeof(uint64_t));
+  if (!values) return 1;
+
+  size_t count = 0, i = 0;
+  for (i = 0; i < max_count; i++) values[i] = i;
+  for (count = 1000; count <= max_count; count *= 10) {
+    list_t lst;
+    lst_init(&lst);
+    for (i = 0; i < count; i++) lst_push_back(&lst, &values[i]);
+    uint8_t* data = NULL;
+    size_t data_sz = 0;
+    FILE* file = fopen(stream_path, "wb");
+    if (!file || transform_lst_to_buffer(lst.head, &data, &data_sz, view_u64) ||
+        fwrite(data, data_sz, 1, file) != 1 || plist_write(plist_path, lst.head, view_u64)) {
+      printf("cannot write files\n");
+      return 1;
+    }
+    fclose(file);
+    free(data);
+    lst_reset(&lst);
+
+    uint64_t last = count - 1;
+    // Rebuild: read the stream and allocate every node and element
+    double t0 = now_ns();
+    data = read_file(stream_path, &data_sz);
+    dlist_t* rebuilt = NULL;
+    transform_buffer_to_lst(data, data_sz, &rebuilt, NULL);
+    double t1 = now_ns();
+    int found1 = list_count(rebuilt, &last, compare_u64);
+    double t2 = now_ns();
+    free(data);
+    list_clear(&rebuilt, NULL);
+
+    // Stream: decode 64 KiB chunks as they are read, only a record cut by a chunk boundary is copied
+    uint8_t chunk[65536];
+    double t6 = now_ns();
+    file = fopen(stream_path, "rb");
+    list_decoder_t decoder;
+    list_decoder_init(&decoder, &rebuilt, NULL, 0);
+    size_t n = 0;
+    while (file && (n = fread(chunk, 1, sizeof(chunk), file)) > 0) list_decoder_feed(&decoder, chunk, n);
+    list_decoder_finish(&decoder);
+    if (file) fclose(file);
+    double t7 = now_ns();
+    int found3 = list_count(rebuilt, &last, compare_u64);
+    list_clear(&rebuilt, NULL);
+
+    // Map: only the header is read at startup
+    plist_t plst;
+    double t3 = now_ns();
+    plist_open(&plst, plist_path);
+    double t4 = now_ns();
+    int found2 = plist_count(&plst, &last, compare_u64);
+    double t5 = now_ns();
+    plist_close(&plst);
+
+    printf("n=%-9zu rebuild %12.0f ns  stream %12.0f ns  count %12.0f ns | plist open %8.0f ns  count %12.0f ns%s\n",
+           count, t1 - t0, t7 - t6, t2 - t1, t4 - t3, t5 - t4,
+           found1 == 1 && found2 == 1 && found3 == 1 ? "" : "  MISMATCH");
+  }
+  remove(stream_path);
+  remove(plist_path);
+  free(values);
+  return 0;
+}
@@ -0,0 +1,97 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "container/list.h"
+#include "container/skiplist.h"
+
+// Ordered insertion into the list is a linear scan, the list is measured up to this size
+#define LIST_MAX_COUNT 10000
+#define LOOKUPS 1000
+
+////////////////////////////////////////////////////////////////////////////
+// Helpers
+////////////////////////////////////////////////////////////////////////////
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+static int compare_u64(const void* data1, const void* data2) {
+  uint64_t value1 = *(const uint64_t*)data1, value2 = *(const uint64_t*)data2;
+  return (value1 > value2) - (value1 < value2);
+}
+static void keep(void* data) { (void)data; }
+// First node not less than 'value', as an ordered list is searched without an index
+static dlist_t* list_lower_bound(dlist_t* lst, const uint64_t* value) {
+  while (lst && compare_u64(lst->data, value) < 0) lst = lst->next;
+  return lst;
+}
+////////////////////////////////////////////////////////////////////////////
+// Time-ordered events: ordered insert, first event at or after a time, and access by rank
+////////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv) {
+  size_t max_count = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : 1000000;
+  uint64_t* times = (uint64_t*)calloc(max_count, sizeof(uint64_t));
+  if (!times) return 1;
+
+  size_t count = 0, i = 0;
+  srand(1);
+  for (i = 0; i < max_count; i++) times[i] = ((uint64_t)rand() << 31) ^ (uint64_t)rand();
+  for (count = 1000; count <= max_count; count *= 10) {
+    double list_insert = 0, list_lower = 0;
+    int valid = 1;
+    if (count <= LIST_MAX_COUNT) {
+      dlist_t* lst = NULL;
+      double t0 = now_ns();
+      for (i = 0; i < count; i++) list_insert_before(&lst, list_lower_bound(lst, &times[i]), &times[i]);
+      double t1 = now_ns();
+      for (i = 0; i < LOOKUPS; i++) valid &= list_lower_bound(lst, &times[i % count]) != NULL;
+      double t2 = now_ns();
+      list_clear(&lst, keep);
+      list_insert = (t1 - t0) / count;
+      list_lower = (t2 - t1) / LOOKUPS;
+    }
+
+    skiplist_t* sl = skiplist_create(compare_u64);
+    double t0 = now_ns();
+    for (i = 0; i < count; i++) skiplist_insert(sl, &times[i]);
+    double t1 = now_ns();
+    for (i = 0; i < LOOKUPS; i++) valid &= skiplist_lower_bound(sl, &times[i % count]) != NULL;
+    double t2 = now_ns();
+    for (i = 0; i < LOOKUPS; i++) valid &= skiplist_at(sl, (i * 7919) % count) != NULL;
+    double t3 = now_ns();
+    skiplist_destroy(sl, keep);
+
+    if (count <= LIST_MAX_COUNT)
+      printf("n=%-9zu list insert %9.1f ns  lower_bound %9.1f ns | ", count, list_insert, list_lower);
+    else
+      printf("n=%-9zu list insert %9s ns  lower_bound %9s ns | ", count, "-", "-");
+    printf("skiplist insert %6.1f ns  lower_bound %6.1f ns  at %6.1f ns%s\n", (t1 - t0) / count, (t2 - t1) / LOOKUPS,
+           (t3 - t2) / LOOKUPS, valid ? "" : "  MISMATCH");
+  }
+  free(times);
+  return 0;
+}
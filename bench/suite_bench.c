@@ -0,0 +1,304 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+
+#include "container/list.h"
+
+// Suite over the list operations, one JSON record per operation, size and access pattern:
+//   suite_bench [--min N] [--max N] [--payload BYTES] [--pattern seq|random]
+// Allocations are counted when built with -DBENCH_COUNT_ALLOCS and linked with
+// -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc (see Makefile), and reported as null otherwise.
+
+////////////////////////////////////////////////////////////////////////////
+// Allocation counting
+////////////////////////////////////////////////////////////////////////////
+static size_t allocs = 0;
+#ifdef BENCH_COUNT_ALLOCS
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void* __wrap_malloc(size_t size) {
+  allocs++;
+  return __real_malloc(size);
+}
+void* __wrap_calloc(size_t count, size_t size) {
+  allocs++;
+  return __real_calloc(count, size);
+}
+void* __wrap_realloc(void* ptr, size_t size) {
+  allocs++;
+  return __real_realloc(ptr, size);
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////
+// Helpers
+////////////////////////////////////////////////////////////////////////////
+typedef struct bench_t {
+  size_t payload_sz;  // Element bytes, the first 8 hold the key
+  const char* pattern;
+  int first;  // No record printed yet
+} bench_t;
+
+static bench_t bench = {16, "seq", 1};
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+static long peak_rss_kb(void) {
+  struct rusage usage;
+  return getrusage(RUSAGE_SELF, &usage) == 0 ? usage.ru_maxrss : -1;
+}
+static uint64_t next_random(uint64_t* state) {
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state;
+}
+static int compare_key(const void* data1, const void* data2) {
+  return memcmp(data1, data2, sizeof(uint64_t)) != 0;
+}
+static void* ctor_payload(size_t count) { return malloc(count * bench.payload_sz); }
+static void copy_payload(const void* src_data, void* dst_data) { memcpy(dst_data, src_data, bench.payload_sz); }
+static const void* view_payload(const void* data, size_t* size) {
+  *size = bench.payload_sz;
+  return data;
+}
+static uint8_t* adapt_payload(void* data) { return (uint8_t*)data; }
+// Functors for transform_lst_to_data_x and transform_data_to_lst_x, one record per element as in the record stream
+static uint8_t* append_record(uint8_t** data, size_t* data_sz, size_t number_elements, ...) {
+  va_list vl;
+  va_start(vl, number_elements);
+  const uint8_t* bytes = va_arg(vl, const uint8_t*);
+  va_end(vl);
+  uint8_t* buf = (uint8_t*)realloc(*data, *data_sz + sizeof(uint64_t) + bench.payload_sz);
+  if (!buf) return NULL;
+  uint64_t size = bench.payload_sz;
+  memcpy(buf + *data_sz, &size, sizeof(size));
+  memcpy(buf + *data_sz + sizeof(size), bytes, bench.payload_sz);
+  *data = buf;
+  *data_sz += sizeof(uint64_t) + bench.payload_sz;
+  return buf;
+}
+static const uint8_t* read_record(const uint8_t* data, size_t* data_sz, size_t number_elements, ...) {
+  va_list vl;
+  va_start(vl, number_elements);
+  uint8_t* bytes = va_arg(vl, uint8_t*);
+  va_end(vl);
+  size_t record_sz = sizeof(uint64_t) + bench.payload_sz;
+  if (*data_sz < record_sz) return NULL;
+  memcpy(bytes, data + sizeof(uint64_t), bench.payload_sz);
+  *data_sz -= record_sz;
+  return data + record_sz;
+}
+static void no_delete(void* data) { (void)data; }
+static void report(const char* op, size_t count, size_t ops, double elapsed, size_t op_allocs) {
+  printf("%s\n  {\"op\": \"%s\", \"n\": %zu, \"payload\": %zu, \"pattern\": \"%s\", ",
+         bench.first ? "" : ",", op, count, bench.payload_sz, bench.pattern);
+  printf("\"ops\": %zu, \"ns_per_op\": %.2f, ", ops, elapsed / (double)ops);
+#ifdef BENCH_COUNT_ALLOCS
+  printf("\"allocs_per_op\": %.3f, ", (double)op_allocs / (double)ops);
+#else
+  (void)op_allocs;
+  printf("\"allocs_per_op\": null, ");
+#endif
+  printf("\"peak_rss_kb\": %ld}", peak_rss_kb());
+  fflush(stdout);
+  bench.first = 0;
+}
+// Builds a list of 'count' elements with keys 0..count-1 in list order. With the random pattern the nodes and payloads
+// are spread over memory in random order, so a traversal does not walk memory sequentially
+static dlist_t* build(uint8_t* payloads, size_t count, int random) {
+  void** data = (void**)malloc(count * sizeof(void*));
+  dlist_t** nodes = (dlist_t**)malloc(count * sizeof(dlist_t*));
+  size_t* order = (size_t*)malloc(count * sizeof(size_t));
+  if (!data || !nodes || !order) exit(1);
+
+  size_t i = 0;
+  uint64_t state = 88172645463325252ull;
+  for (i = 0; i < count; i++) order[i] = i;
+  for (i = count; random && i > 1; i--) {
+    size_t j = (size_t)(next_random(&state) % i);
+    size_t tmp = order[i - 1];
+    order[i - 1] = order[j];
+    order[j] = tmp;
+  }
+  for (i = 0; i < count; i++) data[i] = payloads + order[i] * bench.payload_sz;
+  dlist_t* lst = NULL;
+  if (list_append_array(&lst, data, count) != 0) exit(1);
+  // Element i goes to the node allocated in position order[i]
+  dlist_t* cur = lst;
+  for (i = 0; i < count; i++, cur = cur->next) nodes[i] = cur;
+  for (i = 0; i < count; i++) {
+    dlist_t* node = nodes[order[i]];
+    uint64_t key = i;
+    node->data = data[i];
+    memcpy(node->data, &key, sizeof(key));
+    node->prev = i ? nodes[order[i - 1]] : NULL;
+    node->next = i + 1 < count ? nodes[order[i + 1]] : NULL;
+  }
+  lst = count ? nodes[order[0]] : NULL;
+  free(data);
+  free(nodes);
+  free(order);
+  return lst;
+}
+////////////////////////////////////////////////////////////////////////////
+// Operations
+////////////////////////////////////////////////////////////////////////////
+static void run(size_t count, int random) {
+  uint8_t* payloads = (uint8_t*)calloc(count, bench.payload_sz);
+  if (!payloads) exit(1);
+  dlist_t* lst = build(payloads, count, random);
+  // Operations walking the whole list run this many times
+  size_t scans = 1000000 / count ? 1000000 / count : 1;
+  if (scans > 1000) scans = 1000;
+  size_t i = 0, a = 0;
+  uint64_t state = 2463534242ull;
+
+  // Bare push_back walks to the end from the given node
+  size_t pushes = scans;
+  uint8_t* extra = (uint8_t*)calloc(pushes, bench.payload_sz);
+  if (!extra) exit(1);
+  a = allocs;
+  double t0 = now_ns();
+  for (i = 0; i < pushes; i++) list_push_back(&lst, extra + i * bench.payload_sz);
+  double t1 = now_ns();
+  report("list_push_back", count, pushes, t1 - t0, allocs - a);
+  for (i = 0; i < pushes; i++) list_pop_back(&lst, no_delete);
+  free(extra);
+
+  list_t header;
+  lst_init(&header);
+  a = allocs;
+  t0 = now_ns();
+  for (i = 0; i < count; i++) lst_push_back(&header, payloads + i * bench.payload_sz);
+  t1 = now_ns();
+  report("lst_push_back", count, count, t1 - t0, allocs - a);
+  lst_reset(&header);
+
+  volatile int sink = 0;
+  a = allocs;
+  t0 = now_ns();
+  for (i = 0; i < scans; i++) sink += list_size(lst);
+  t1 = now_ns();
+  report("list_size", count, scans, t1 - t0, allocs - a);
+
+  a = allocs;
+  t0 = now_ns();
+  for (i = 0; i < scans; i++) {
+    uint64_t key = next_random(&state) % count;
+    sink += list_find(lst, &key, compare_key) != NULL;
+  }
+  t1 = now_ns();
+  report("list_find", count, scans, t1 - t0, allocs - a);
+  (void)sink;
+
+  dlist_t* copy = NULL;
+  a = allocs;
+  t0 = now_ns();
+  list_copy(lst, &copy, ctor_payload, NULL, copy_payload);
+  t1 = now_ns();
+  report("list_copy", count, count, t1 - t0, allocs - a);
+
+  a = allocs;
+  t0 = now_ns();
+  list_clear(&copy, NULL);
+  t1 = now_ns();
+  report("list_clear", count, count, t1 - t0, allocs - a);
+
+  uint8_t* data = NULL;
+  size_t data_sz = 0;
+  a = allocs;
+  t0 = now_ns();
+  transform_lst_to_buffer(lst, &data, &data_sz, view_payload);
+  t1 = now_ns();
+  report("transform_lst_to_buffer", count, count, t1 - t0, allocs - a);
+
+  a = allocs;
+  t0 = now_ns();
+  transform_buffer_to_lst(data, data_sz, &copy, NULL);
+  t1 = now_ns();
+  report("transform_buffer_to_lst", count, count, t1 - t0, allocs - a);
+  list_clear(&copy, NULL);
+  free(data);
+
+  data = NULL;
+  data_sz = 0;
+  a = allocs;
+  t0 = now_ns();
+  transform_lst_to_data_x(lst, &data, &data_sz, append_record, 1, (void*)adapt_payload);
+  t1 = now_ns();
+  report("transform_lst_to_data_x", count, count, t1 - t0, allocs - a);
+
+  a = allocs;
+  t0 = now_ns();
+  transform_data_to_lst_x(data, &data_sz, &copy, bench.payload_sz, read_record, 1, (void*)adapt_payload);
+  t1 = now_ns();
+  report("transform_data_to_lst_x", count, count, t1 - t0, allocs - a);
+  list_clear(&copy, NULL);
+  free(data);
+
+  list_clear(&lst, no_delete);
+  free(payloads);
+}
+
+int main(int argc, char** argv) {
+  size_t min_count = 1000, max_count = 10000000, count = 0;
+  const char* patterns[] = {"seq", "random"};
+  int first_pattern = 0, last_pattern = 1, p = 0, i = 0;
+
+  for (i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--min") && i + 1 < argc) {
+      min_count = (size_t)strtoull(argv[++i], NULL, 10);
+    } else if (!strcmp(argv[i], "--max") && i + 1 < argc) {
+      max_count = (size_t)strtoull(argv[++i], NULL, 10);
+    } else if (!strcmp(argv[i], "--payload") && i + 1 < argc) {
+      bench.payload_sz = (size_t)strtoull(argv[++i], NULL, 10);
+    } else if (!strcmp(argv[i], "--pattern") && i + 1 < argc &&
+               (!strcmp(argv[i + 1], "seq") || !strcmp(argv[i + 1], "random"))) {
+      i++;
+      first_pattern = last_pattern = strcmp(argv[i], "random") ? 0 : 1;
+    } else {
+      fprintf(stderr, "usage: %s [--min N] [--max N] [--payload BYTES] [--pattern seq|random]\n", argv[0]);
+      return 1;
+    }
+  }
+  // The key is stored in the payload
+  if (bench.payload_sz < sizeof(uint64_t)) bench.payload_sz = sizeof(uint64_t);
+  if (min_count == 0) min_count = 1;
+
+  printf("[");
+  for (p = first_pattern; p <= last_pattern; p++) {
+    bench.pattern = patterns[p];
+    for (count = min_count; count <= max_count; count *= 10) run(count, p);
+  }
+  printf("\n]\n");
+  return 0;
+}
@@ -0,0 +1,98 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "container/list.h"
+#include "container/tlist.h"
+
+static inline int compare_i64_typed(const int64_t* a, const int64_t* b) { return (*a > *b) - (*a < *b); }
+CLC_DLIST_DEFINE(i64list, int64_t, compare_i64_typed)
+
+////////////////////////////////////////////////////////////////////////////
+// Helpers
+////////////////////////////////////////////////////////////////////////////
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+static int compare_i64(const void* data1, const void* data2) {
+  return compare_i64_typed((const int64_t*)data1, (const int64_t*)data2);
+}
+////////////////////////////////////////////////////////////////////////////
+// int64 payloads: list_t with a separately allocated payload and a predicate call per comparison, against the
+// generated list holding the value inline with the comparison inlined
+////////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv) {
+  size_t max_count = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : 1000000;
+  size_t count = 0, i = 0, pass = 0;
+  // Sorted lists are freed in value order, which scatters the heap for whatever is allocated next, so the sort pass
+  // runs after the others
+  for (pass = 0; pass < 2; pass++) {
+    for (count = 1000; count <= max_count; count *= 10) {
+      int64_t key = 7;
+      srand(1);
+      i64list_t typed;
+      i64list_init(&typed);
+      double t0 = now_ns();
+      for (i = 0; i < count; i++) i64list_push_back(&typed, rand() % 1000);
+      double t1 = now_ns();
+      size_t found1 = i64list_count(&typed, &key);
+      double t2 = now_ns();
+      if (pass) i64list_sort(&typed);
+      double t3 = now_ns();
+      i64list_clear(&typed);
+      double t4 = now_ns();
+
+      srand(1);
+      list_t lst;
+      lst_init(&lst);
+      double t5 = now_ns();
+      for (i = 0; i < count; i++) {
+        int64_t* data = (int64_t*)malloc(sizeof(int64_t));
+        *data = rand() % 1000;
+        lst_push_back(&lst, data);
+      }
+      double t6 = now_ns();
+      int found2 = lst_count(&lst, &key, compare_i64);
+      double t7 = now_ns();
+      if (pass) lst_sort(&lst, compare_i64);
+      double t8 = now_ns();
+      lst_clear(&lst, NULL);
+      double t9 = now_ns();
+
+      const char* mismatch = (size_t)found2 == found1 ? "" : "  MISMATCH";
+      if (pass)
+        printf("n=%-9zu list_t sort %7.1f ns/elem | tlist sort %7.1f ns/elem%s\n", count, (t8 - t7) / count,
+               (t3 - t2) / count, mismatch);
+      else
+        printf("n=%-9zu list_t push %6.1f count %6.2f clear %6.1f | tlist push %6.1f count %6.2f clear %6.1f "
+               "ns/elem%s\n",
+               count, (t6 - t5) / count, (t7 - t6) / count, (t9 - t8) / count, (t1 - t0) / count, (t2 - t1) / count,
+               (t4 - t3) / count, mismatch);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,83 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "container/list.h"
+#include "container/ulist.h"
+
+////////////////////////////////////////////////////////////////////////////
+// Helpers
+////////////////////////////////////////////////////////////////////////////
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+static int is_equal(const void* data1, const void* data2) { return *(const int*)data1 != *(const int*)data2; }
+// Payloads belong to the values array
+static void keep(void* data) { (void)data; }
+////////////////////////////////////////////////////////////////////////////
+// Full scan: dlist_t against ulist_t
+////////////////////////////////////////////////////////////////////////////
+int main(void) {
+  const size_t max_count = 10000000;
+  int* values = (int*)calloc(max_count, sizeof(int));
+  if (!values) return 1;
+
+  size_t count = 0, i = 0;
+  for (i = 0; i < max_count; i++) values[i] = (int)(i % 1000);
+  const int value = -1;  // Not found, every scan visits all elements
+
+  for (count = 10000; count <= max_count; count *= 10) {
+    size_t rounds = max_count / count > 100 ? 100 : max_count / count;
+    size_t r = 0;
+
+    list_t lst;
+    lst_init(&lst);
+    ulist_t ulst;
+    ulist_init(&ulst);
+    for (i = 0; i < count; i++) {
+      lst_push_back(&lst, &values[i]);
+      ulist_push_back(&ulst, &values[i]);
+    }
+
+    double t0 = now_ns();
+    for (r = 0; r < rounds; r++)
+      if (list_count(lst.head, &value, is_equal) != 0) return 1;
+    double t1 = now_ns();
+    for (r = 0; r < rounds; r++)
+      if (ulist_count(&ulst, &value, is_equal) != 0) return 1;
+    double t2 = now_ns();
+
+    double dlist_ns = (t1 - t0) / (double)(count * rounds);
+    double ulist_ns = (t2 - t1) / (double)(count * rounds);
+    printf("n=%-9zu dlist %6.2f ns/elem (%7.1f M/s)  ulist %6.2f ns/elem (%7.1f M/s)\n", count, dlist_ns,
+           1e3 / dlist_ns, ulist_ns, 1e3 / ulist_ns);
+
+    lst_reset(&lst);
+    ulist_clear(&ulst, keep);
+  }
+  free(values);
+  return 0;
+}
@@ -0,0 +1,83 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "container/list.h"
+#include "container/vector.h"
+
+////////////////////////////////////////////////////////////////////////////
+// Helpers
+////////////////////////////////////////////////////////////////////////////
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+static int compare_i32(const void* data1, const void* data2) {
+  return *(const int32_t*)data1 != *(const int32_t*)data2;
+}
+////////////////////////////////////////////////////////////////////////////
+// Count of an int32 key: pointer-chasing list, generic vector scan and typed SIMD kernels
+////////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv) {
+  size_t max_count = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : 10000000;
+  int32_t* values = (int32_t*)calloc(max_count, sizeof(int32_t));
+  if (!values) return 1;
+
+  size_t count = 0, i = 0;
+  srand(1);
+  for (i = 0; i < max_count; i++) values[i] = rand() % 1000;
+  for (count = 1000; count <= max_count; count *= 10) {
+    list_t lst;
+    vector_t vec;
+    lst_init(&lst);
+    vector_init(&vec, sizeof(int32_t));
+    vector_reserve(&vec, count);
+    for (i = 0; i < count; i++) {
+      lst_push_back(&lst, &values[i]);
+      vector_push_back(&vec, &values[i]);
+    }
+    int32_t key = 7, min = 0, max = 0;
+
+    double t0 = now_ns();
+    int found1 = lst_count(&lst, &key, compare_i32);
+    double t1 = now_ns();
+    int found2 = vector_count(&vec, &key, compare_i32);
+    double t2 = now_ns();
+    size_t found3 = vector_count_i32(&vec, key);
+    double t3 = now_ns();
+    vector_min_i32(&vec, &min);
+    vector_max_i32(&vec, &max);
+    double t4 = now_ns();
+
+    printf("n=%-9zu list count %6.2f ns/elem  vector count %6.2f ns/elem  count_i32 %6.3f ns/elem"
+           "  min+max %6.3f ns/elem%s\n",
+           count, (t1 - t0) / count, (t2 - t1) / count, (t3 - t2) / count, (t4 - t3) / count,
+           found1 == found2 && (size_t)found2 == found3 && min == 0 && max == 999 ? "" : "  MISMATCH");
+    lst_reset(&lst);
+    vector_destroy(&vec, NULL);
+  }
+  free(values);
+  return 0;
+}
@@ -0,0 +1,71 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#ifndef _ARENA_H
+#define _ARENA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "container/list.h"
+
+typedef struct arena_block_t {
+  struct arena_block_t* next;
+} arena_block_t;
+
+// Fixed-size object arena. Objects are carved from large blocks, freed objects are recycled through a free list, and
+// all objects can be dropped at once by rewinding the arena to its first block.
+typedef struct arena_t {
+  arena_block_t* blocks;   // All blocks, in allocation order
+  arena_block_t* current;  // Block objects are being carved from
+  uint8_t* cur;            // Next free byte in the current block
+  uint8_t* end;            // End of the current block
+  void* free_list;         // Recycled objects
+  size_t elem_sz;
+  size_t block_elems;
+} arena_t;
+
+////////////////////////////////////////////////////////////////////////////
+// Arena
+////////////////////////////////////////////////////////////////////////////
+// Construct arena. Objects are 'elem_sz' bytes large and blocks hold 'block_elems' objects each. Returns 0 on success.
+int arena_init(arena_t* arena, size_t elem_sz, size_t block_elems);
+// Allocate object. Returns a pointer to an uninitialized object, or null on failure.
+void* arena_alloc(arena_t* arena);
+// Free object. The object is recycled by the next allocation.
+void arena_free(arena_t* arena, void* ptr);
+// Drops all objects at once. The blocks are kept for the next allocations, so this takes constant time.
+void arena_reset(arena_t* arena);
+// Destroy arena. Returns all blocks to the heap.
+void arena_destroy(arena_t* arena);
+// Fill list allocator. Sets 'allocator' up to take list nodes from 'arena'. The arena is released together with the
+// list, so it must be dedicated to a single list.
+void arena_list_allocator(arena_t* arena, list_allocator_t* allocator);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  //_ARENA_H
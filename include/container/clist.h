@@ -0,0 +1,73 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#ifndef _CLIST_H
+#define _CLIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+// Thread-safe doubly linked list. Every node carries its own reader-writer lock and traversals take them hand over hand
+// from the front, so readers never block each other and writers at different positions do not contend. Elements are
+// void* as in list.h.
+typedef struct clist_t clist_t;
+
+////////////////////////////////////////////////////////////////////////////
+// Concurrent list
+////////////////////////////////////////////////////////////////////////////
+// Construct list. Returns null on failure.
+clist_t* clist_create(void);
+// Destroy list. Calls 'deleter' for every element, free when it is null. No thread may use the list anymore.
+void clist_destroy(clist_t* lst, void (*deleter)(void* data));
+// Add element at the end. Returns 0 on success.
+int clist_push_back(clist_t* lst, void* data);
+// Insert element at beginning. Returns 0 on success.
+int clist_push_front(clist_t* lst, void* data);
+// Remove first element. Returns the element, which now belongs to the caller, or null if the list is empty.
+void* clist_pop_front(clist_t* lst);
+// Insert element before the first element equal to 'value', or at the end if there is none. Returns 0 on success.
+int clist_insert_before(clist_t* lst, const void* value, int (*predicate)(const void* data1, const void* data2),
+                        void* data);
+// Erase the first element equal to 'value', calling 'deleter' for it (free when it is null). Returns 1 if an element
+// was erased and 0 otherwise.
+int clist_erase(clist_t* lst, const void* value, int (*predicate)(const void* data1, const void* data2),
+                void (*deleter)(void* data));
+// Searches the list for the first element equal to 'value' and applies fn to it while the element is locked for
+// reading. fn may be null. Returns 1 if an element was found and 0 otherwise.
+int clist_find(clist_t* lst, const void* value, int (*predicate)(const void* data1, const void* data2),
+               void (*fn)(void* data, void* ctx), void* ctx);
+// Returns the number of elements equal to 'value'.
+int clist_count(clist_t* lst, const void* value, int (*predicate)(const void* data1, const void* data2));
+// Applies function fn to each of the elements, locked for reading, in order. fn must not modify the list.
+void clist_for_each(clist_t* lst, void (*fn)(void* data, void* ctx), void* ctx);
+// Returns the number of elements. The answer may be outdated by the time it is returned.
+size_t clist_size(const clist_t* lst);
+// Test whether container is empty. The answer may be outdated by the time it is returned.
+int clist_empty(const clist_t* lst);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  //_CLIST_H
@@ -0,0 +1,80 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#ifndef _DEQUE_H
+#define _DEQUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+// Double-ended queue of void* elements in a growable ring buffer. The capacity is a power of two and positions wrap
+// with a mask, so both ends push and pop in constant time without allocating per element. Deleters follow list.h:
+// elements are released with free when the deleter is null.
+typedef struct deque_t {
+  void** data;
+  size_t capacity;  // Power of two, or 0
+  size_t head;      // Position of the first element
+  size_t size;
+} deque_t;
+
+////////////////////////////////////////////////////////////////////////////
+// Deque
+////////////////////////////////////////////////////////////////////////////
+// Construct deque. Initializes an empty deque.
+void deque_init(deque_t* dq);
+// Destroy deque. Calls 'deleter' for every element and releases the storage.
+void deque_destroy(deque_t* dq, void (*deleter)(void* data));
+// Request a change in capacity. Makes room for at least 'count' elements. Returns 0 on success.
+int deque_reserve(deque_t* dq, size_t count);
+// Add element at the end. Returns 0 on success.
+int deque_push_back(deque_t* dq, void* data);
+// Insert element at beginning. Returns 0 on success.
+int deque_push_front(deque_t* dq, void* data);
+// Add 'count' elements from 'data' at the end, in order. Returns 0 on success, nothing is added on failure.
+int deque_push_n(deque_t* dq, void* const* data, size_t count);
+// Delete first element, calling 'deleter' for it.
+void deque_pop_front(deque_t* dq, void (*deleter)(void* data));
+// Delete last element, calling 'deleter' for it.
+void deque_pop_back(deque_t* dq, void (*deleter)(void* data));
+// Remove up to 'count' elements from the beginning into 'data', in order. They now belong to the caller. Returns the
+// number of elements removed.
+size_t deque_pop_n(deque_t* dq, void** data, size_t count);
+// Access element. Returns the element at position 'pos' from the beginning, or null when out of range.
+void* deque_at(const deque_t* dq, size_t pos);
+// Access first element, or null if the deque is empty.
+void* deque_front(const deque_t* dq);
+// Access last element, or null if the deque is empty.
+void* deque_back(const deque_t* dq);
+// Return size. Returns the number of elements in the deque.
+size_t deque_size(const deque_t* dq);
+// Test whether container is empty.
+int deque_empty(const deque_t* dq);
+// Removes all elements, calling 'deleter' for each of them. The storage is kept.
+void deque_clear(deque_t* dq, void (*deleter)(void* data));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  //_DEQUE_H
@@ -0,0 +1,73 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#ifndef _HASHMAP_H
+#define _HASHMAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+// Hash map of void* elements, the replacement for a list used as a key-value store through list_push_back_unique and
+// list_find. Elements are looked up by 'value' as in list.h: 'predicate' returns 0 when an element is equal to 'value',
+// and 'hash' must give equal hashes for an element and any value equal to it. Slots are a flat array probed with Robin
+// Hood linear probing. Growing does not rehash everything at once: the previous table is moved into the new one a few
+// slots per insert or erase. Elements must not be null.
+typedef struct hashmap_t hashmap_t;
+
+////////////////////////////////////////////////////////////////////////////
+// Hash map
+////////////////////////////////////////////////////////////////////////////
+// Construct map. Returns null on failure.
+hashmap_t* hashmap_create(size_t (*hash)(const void* data), int (*predicate)(const void* data1, const void* data2));
+// Destroy map. Calls 'deleter' for every element, free when it is null.
+void hashmap_destroy(hashmap_t* map, void (*deleter)(void* data));
+// Request a change in capacity. Makes room for at least 'count' elements without growing. Returns 0 on success.
+int hashmap_reserve(hashmap_t* map, size_t count);
+// Insert element, if no element equal to it exists. Returns 0 if it was inserted, 1 if an equal element exists (and
+// 'data' still belongs to the caller) and -1 on failure.
+int hashmap_insert(hashmap_t* map, void* data);
+// Insert or replace element. An equal element is replaced and goes to 'deleter' (free when it is null), unless it is
+// 'data' itself, which is then left in place. Returns 0 on success.
+int hashmap_put(hashmap_t* map, void* data, void (*deleter)(void* data));
+// Searches the map for the element equal to 'value', returns it or null.
+void* hashmap_find(const hashmap_t* map, const void* value);
+// Remove the element equal to 'value'. Returns the element, which now belongs to the caller, or null if there is none.
+void* hashmap_remove(hashmap_t* map, const void* value);
+// Erase the element equal to 'value', calling 'deleter' for it (free when it is null). Returns 1 if an element was
+// erased and 0 otherwise.
+int hashmap_erase(hashmap_t* map, const void* value, void (*deleter)(void* data));
+// Applies function fn to each of the elements, in no particular order. fn must not modify the map.
+int hashmap_for_each(hashmap_t* map, int (*fn)(void* data, void* ctx), void* ctx);
+// Removes all elements, calling 'deleter' for each of them (free when it is null). The storage is kept.
+void hashmap_clear(hashmap_t* map, void (*deleter)(void* data));
+// Return size. Returns the number of elements in the map.
+size_t hashmap_size(const hashmap_t* map);
+// Test whether container is empty.
+int hashmap_empty(const hashmap_t* map);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  //_HASHMAP_H
@@ -0,0 +1,92 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#ifndef _ILIST_H
+#define _ILIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Intrusive list link. Embedded into the user record, so linking a record costs no allocation.
+typedef struct ilist_link_t {
+  struct ilist_link_t* next;
+  struct ilist_link_t* prev;
+} ilist_link_t;
+
+// Intrusive list header
+typedef struct ilist_t {
+  ilist_link_t* head;
+  ilist_link_t* tail;
+  size_t size;
+} ilist_t;
+
+// Access record. Returns a pointer to the record of 'type' embedding 'link' as its 'member'.
+#define ILIST_ENTRY(link, type, member) ((type*)((char*)(link)-offsetof(type, member)))
+
+////////////////////////////////////////////////////////////////////////////
+// Intrusive list
+////////////////////////////////////////////////////////////////////////////
+// Construct list. Initializes an empty list header.
+void ilist_init(ilist_t* lst);
+// Add element at the end. Links 'link' after the current last element.
+void ilist_push_back(ilist_t* lst, ilist_link_t* link);
+// Insert element at beginning. Links 'link' before the current first element.
+void ilist_push_front(ilist_t* lst, ilist_link_t* link);
+// Delete first element. Unlinks the first element and returns it, or null if the list is empty.
+ilist_link_t* ilist_pop_front(ilist_t* lst);
+// Delete last element. Unlinks the last element and returns it, or null if the list is empty.
+ilist_link_t* ilist_pop_back(ilist_t* lst);
+// Unlinks 'link' from the list. The record itself is left untouched.
+void ilist_erase(ilist_t* lst, ilist_link_t* link);
+// Access first element.
+ilist_link_t* ilist_front(const ilist_t* lst);
+// Access last element.
+ilist_link_t* ilist_back(const ilist_t* lst);
+// Return size. Returns the number of elements in the list container.
+size_t ilist_size(const ilist_t* lst);
+// Test whether container is empty. Returns whether the list container is empty (i.e. whether its size is 0).
+int ilist_empty(const ilist_t* lst);
+// Unlinks all elements, calling 'deleter' (if any) for each of them, and leaving the container with a size of 0.
+void ilist_clear(ilist_t* lst, void (*deleter)(ilist_link_t* link));
+////////////////////////////////////////////////////////////////////////////
+// Algorithms
+////////////////////////////////////////////////////////////////////////////
+// Applies function fn to each of the elements. The element may be unlinked by fn.
+int ilist_for_each(ilist_t* lst, int (*fn)(ilist_link_t* link));
+// Returns the number of elements for which predicate returns 0.
+int ilist_count(const ilist_t* lst, const void* value, int (*predicate)(const ilist_link_t* link, const void* value));
+// Searches the list for the first element for which predicate returns 0, or null if there is none.
+ilist_link_t* ilist_find(const ilist_t* lst, const void* value,
+                         int (*predicate)(const ilist_link_t* link, const void* value));
+// Unlinks all the elements for which predicate returns 0, calling 'deleter' (if any) for each of them. Returns the
+// number of removed elements.
+int ilist_remove_if(ilist_t* lst, const void* value, int (*predicate)(const ilist_link_t* link, const void* value),
+                    void (*deleter)(ilist_link_t* link));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  //_ILIST_H
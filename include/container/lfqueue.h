@@ -0,0 +1,62 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#ifndef _LFQUEUE_H
+#define _LFQUEUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Lock-free multi-producer/multi-consumer FIFO queue (Michael-Scott queue). Removed nodes are reclaimed through hazard
+// pointers, so a node is never freed while another thread may still read it.
+typedef struct lfqueue_t lfqueue_t;
+// Per-thread access to a queue. Holds the hazard pointers and the nodes waiting for reclamation of one thread.
+typedef struct lfqueue_handle_t lfqueue_handle_t;
+
+////////////////////////////////////////////////////////////////////////////
+// Lock-free queue
+////////////////////////////////////////////////////////////////////////////
+// Construct queue. Returns null on failure.
+lfqueue_t* lfqueue_create(void);
+// Destroy queue. Calls 'deleter' for every element left in the queue. No thread may use the queue anymore, handles
+// that were not released are freed as well.
+void lfqueue_destroy(lfqueue_t* queue, void (*deleter)(void* data));
+// Acquire handle. Every thread using the queue needs its own handle; released handles are reused. Returns null on
+// failure.
+lfqueue_handle_t* lfqueue_acquire(lfqueue_t* queue);
+// Release handle. The calling thread must not use the handle anymore.
+void lfqueue_release(lfqueue_handle_t* handle);
+// Add element at the end. Returns 0 on success.
+int lfqueue_push(lfqueue_handle_t* handle, void* data);
+// Remove first element. Returns the element, which now belongs to the caller, or null if the queue is empty.
+void* lfqueue_pop(lfqueue_handle_t* handle);
+// Test whether container is empty. The answer may be outdated by the time it is returned.
+int lfqueue_empty(const lfqueue_t* queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  //_LFQUEUE_H
@@ -26,14 +26,46 @@
 extern "C" {
 #endif
 
+#include <stddef.h>
 #include <stdint.h>
 
+struct iovec;  // Only handled through pointers, <sys/uio.h> defines it
+
+// Maximum number of payloads handed to a batched deleter at once
+#ifndef LIST_ERASE_BATCH
+#define LIST_ERASE_BATCH 64
+#endif
+// Alignment of the records written by transform_lst_to_buffer
+#define LIST_RECORD_ALIGN 8
+
 typedef struct dlist_t {
   void* data;
   struct dlist_t* next;
   struct dlist_t* prev;
 } dlist_t;
 
+// Node allocator. 'alloc' returns storage for one node of 'size' bytes and 'free' gives it back. 'release' is
+// optional: when set, it drops every node handed out by the allocator in one step, which lets a list be cleared without
+// freeing its nodes one by one. An allocator with 'release' must not be shared between lists.
+typedef struct list_allocator_t {
+  void* (*alloc)(void* ctx, size_t size);
+  void (*free)(void* ctx, void* ptr);
+  void (*release)(void* ctx);
+  void* ctx;
+} list_allocator_t;
+
+// List header. Tracks the first and the last node and the number of elements, so operations at both ends and size
+// queries run in constant time. The node chain starting at 'head' is a regular dlist_t list and can be passed to any
+// algorithm below. Nodes come from 'allocator', or from calloc/free when it is null. 'index' is the optional hash index
+// enabled by lst_index_enable.
+typedef struct list_t {
+  dlist_t* head;
+  dlist_t* tail;
+  size_t size;
+  const list_allocator_t* allocator;
+  struct list_index_t* index;
+} list_t;
+
 ////////////////////////////////////////////////////////////////////////////
 // List
 ////////////////////////////////////////////////////////////////////////////
@@ -49,8 +81,34 @@ int list_push_back_unique(dlist_t** lst, const void* value, void* src,
 // of these objects and reduces the container size by the number of elements removed.
 void list_remove_if(dlist_t** lst, const void* value, int (*predicate)(const void* data1, const void* data2),
                     void (*deleter)(void* data));
+// Erase elements. Removes in a single pass all the elements for which predicate returns 0, calling 'deleter' for each
+// of them. Returns the number of removed elements.
+int list_erase_if(dlist_t** lst, const void* value, int (*predicate)(const void* data1, const void* data2),
+                  void (*deleter)(void* data));
+// Erase elements. Same as list_erase_if, but the payloads of the removed elements are handed to 'deleter_n' in batches
+// of up to LIST_ERASE_BATCH. The array is only valid during the call, the pointers must be copied to destroy the
+// payloads later or on another thread.
+int list_erase_if_batch(dlist_t** lst, const void* value, int (*predicate)(const void* data1, const void* data2),
+                        void (*deleter_n)(void** data, size_t count));
+// Sort elements in container. Sorts the elements in the list in ascending order of 'compare', which returns a value
+// less than, equal to or greater than 0 like the predicates above. The sort is a stable, in-place merge sort that only
+// relinks the nodes.
+int list_sort(dlist_t** lst, int (*compare)(const void* data1, const void* data2));
+// Merge sorted lists. Merges the sorted 'src' into the sorted 'dst' by relinking the nodes, equal elements of 'dst' go
+// first. 'src' is left empty. The lists must be distinct chains, -1 is returned if 'dst' and 'src' are nodes of the
+// same list.
+int list_merge(dlist_t** dst, dlist_t** src, int (*compare)(const void* data1, const void* data2));
+// Remove duplicate values. Removes every element for which predicate returns 0 against the element right before it,
+// calling 'deleter' for each of them. Returns the number of removed elements.
+int list_unique(dlist_t** lst, int (*predicate)(const void* data1, const void* data2), void (*deleter)(void* data));
 // Removes all elements from the list container (which are destroyed), and leaving the container with a size of 0.
 void list_clear(dlist_t** lst, void (*deleter)(void* data));
+// Append elements. Adds 'count' elements from 'data' at the end of the list container in a single pass. Either all
+// elements are added, or none is and -1 is returned.
+int list_append_array(dlist_t** lst, void* const* data, size_t count);
+// Concatenate lists. Moves all nodes of 'src' at the end of 'dst', no node is allocated or freed, 'src' is left empty.
+// Returns -1 if 'dst' and 'src' are nodes of the same list.
+int list_concat(dlist_t** dst, dlist_t** src);
 // Returns a const pointer to the first element in the list container.
 const dlist_t* list_cfront(const dlist_t* lst);
 // Access first element. Returns a pointer to the first element in the list container.
@@ -61,39 +119,157 @@ dlist_t* list_back(dlist_t* lst);
 void list_pop_front(dlist_t** lst, void (*deleter)(void* data));
 // Delete last element. Removes the last element in the list container, effectively reducing the container size by one.
 void list_pop_back(dlist_t** lst, void (*deleter)(void* data));
+// Insert element. Inserts a new element right before node 'pos' in constant time; a null 'pos' adds it at the end.
+// '*lst' is moved to the new node if it pointed to 'pos'. Returns the new node, or null on failure.
+dlist_t* list_insert_before(dlist_t** lst, dlist_t* pos, void* data);
+// Insert element. Inserts a new element right after node 'pos' in constant time; a null 'pos' adds it at the
+// beginning. Returns the new node, or null on failure.
+dlist_t* list_insert_after(dlist_t** lst, dlist_t* pos, void* data);
+// Erase element. Removes node 'node' in constant time, calling 'deleter' for its element. If '*lst' pointed to it,
+// '*lst' is moved to the next node (the previous one at the end).
+void list_erase(dlist_t** lst, dlist_t* node, void (*deleter)(void* data));
+// Move element to the beginning. Relinks 'node' before the first node in constant time when '*lst' is the first node,
+// which is then moved to 'node'.
+void list_move_to_front(dlist_t** lst, dlist_t* node);
+// Move element to the end. Relinks 'node' after the last node; the last node is looked up from '*lst' as in
+// list_push_back, use lst_move_to_back for constant time.
+void list_move_to_back(dlist_t** lst, dlist_t* node);
 // Test whether container is empty. Returns whether the list container is empty (i.e. whether its size is 0).
 int list_empty(const dlist_t* lst);
 // Return size. Returns the number of elements in the list container.
 int list_size(const dlist_t* lst);
 ////////////////////////////////////////////////////////////////////////////
+// List header
+////////////////////////////////////////////////////////////////////////////
+// Construct list. Initializes an empty list header.
+void lst_init(list_t* lst);
+// Construct list with allocator. Initializes an empty list header which takes its nodes from 'allocator'. The
+// allocator must outlive the list.
+void lst_init_allocator(list_t* lst, const list_allocator_t* allocator);
+// Add element at the end. Adds a new element at the end of the list container, after its current last element.
+// Returns the new node, or null on failure.
+dlist_t* lst_push_back(list_t* lst, void* data);
+// Insert element at beginning. Inserts a new element at the beginning of the list, right before its current first
+// element. Returns the new node, or null on failure.
+dlist_t* lst_push_front(list_t* lst, void* data);
+// Delete first element. Removes the first element in the list container, effectively reducing its size by one.
+void lst_pop_front(list_t* lst, void (*deleter)(void* data));
+// Delete last element. Removes the last element in the list container, effectively reducing the container size by one.
+void lst_pop_back(list_t* lst, void (*deleter)(void* data));
+// Insert element. Inserts a new element right before node 'pos' in constant time; a null 'pos' adds it at the end.
+// Returns the new node, or null on failure.
+dlist_t* lst_insert_before(list_t* lst, dlist_t* pos, void* data);
+// Insert element. Inserts a new element right after node 'pos' in constant time; a null 'pos' adds it at the
+// beginning. Returns the new node, or null on failure.
+dlist_t* lst_insert_after(list_t* lst, dlist_t* pos, void* data);
+// Erase element. Removes node 'node' in constant time, calling 'deleter' for its element.
+void lst_erase(list_t* lst, dlist_t* node, void (*deleter)(void* data));
+// Move element to the beginning in constant time, no node is allocated or freed.
+void lst_move_to_front(list_t* lst, dlist_t* node);
+// Move element to the end in constant time, no node is allocated or freed.
+void lst_move_to_back(list_t* lst, dlist_t* node);
+// Access first element. Returns a pointer to the first node in the list container.
+dlist_t* lst_front(const list_t* lst);
+// Access last element. Returns a pointer to the last node in the list container.
+dlist_t* lst_back(const list_t* lst);
+// Return size. Returns the number of elements in the list container.
+size_t lst_size(const list_t* lst);
+// Test whether container is empty. Returns whether the list container is empty (i.e. whether its size is 0).
+int lst_empty(const list_t* lst);
+// Removes all elements from the list container (which are destroyed), and leaving the container with a size of 0.
+void lst_clear(list_t* lst, void (*deleter)(void* data));
+// Removes all nodes from the list container without destroying the elements they point to. With a releasing allocator
+// this takes constant time, the nodes are not visited.
+void lst_reset(list_t* lst);
+// Append elements. Adds 'count' elements from 'data' at the end of the list container in a single pass. Either all
+// elements are added, or none is and -1 is returned.
+int lst_append_array(list_t* lst, void* const* data, size_t count);
+// Transfer elements from list to list. Moves all nodes of 'src' into 'dst' right before 'pos' (at the end when 'pos' is
+// null) in constant time, no node is allocated or freed. Both lists must use the same allocator.
+int lst_splice(list_t* dst, dlist_t* pos, list_t* src);
+// Transfer elements from list to list. Moves the nodes [first,last) of 'src' into 'dst' right before 'pos'; a null
+// 'last' stands for the end of 'src'. Relinking is constant time, the moved nodes are counted to keep both sizes.
+int lst_splice_range(list_t* dst, dlist_t* pos, list_t* src, dlist_t* first, dlist_t* last);
+// Concatenate lists. Moves all nodes of 'src' at the end of 'dst' in constant time, 'src' is left empty.
+int lst_concat(list_t* dst, list_t* src);
+// Erase elements. Removes in a single pass all the elements for which predicate returns 0, calling 'deleter' for each
+// of them. Returns the number of removed elements.
+int lst_erase_if(list_t* lst, const void* value, int (*predicate)(const void* data1, const void* data2),
+                 void (*deleter)(void* data));
+// Erase elements. Same as lst_erase_if, with the payloads handed to 'deleter_n' in batches (see list_erase_if_batch).
+int lst_erase_if_batch(list_t* lst, const void* value, int (*predicate)(const void* data1, const void* data2),
+                       void (*deleter_n)(void** data, size_t count));
+// Sort elements in container. Stable, in-place merge sort (see list_sort).
+int lst_sort(list_t* lst, int (*compare)(const void* data1, const void* data2));
+// Merge sorted lists. Merges the sorted 'src' into the sorted 'dst', 'src' is left empty (see list_merge).
+int lst_merge(list_t* dst, list_t* src, int (*compare)(const void* data1, const void* data2));
+// Remove duplicate values. Removes consecutive equal elements (see list_unique).
+int lst_unique(list_t* lst, int (*predicate)(const void* data1, const void* data2), void (*deleter)(void* data));
+// Enable hash index. Builds a side index over the elements keyed by 'hash', where elements equal under 'predicate' must
+// have equal hashes. While enabled, the index follows every change made through the lst_* functions (splicing then
+// visits the moved nodes), and lookups with the same predicate (or a null one) run in expected constant time. Indexed
+// fields of an element must not change while it is in the list. Returns 0 on success.
+int lst_index_enable(list_t* lst, size_t (*hash)(const void* data),
+                     int (*predicate)(const void* data1, const void* data2));
+// Disable hash index. Frees the index, it must be called before the list header goes away.
+void lst_index_disable(list_t* lst);
+// Searches the list for an element equal to 'value'. Without index, or with another predicate, this is list_find;
+// with index and equal elements, the one indexed first is returned.
+dlist_t* lst_find(list_t* lst, const void* value, int (*predicate)(const void* data1, const void* data2));
+const dlist_t* lst_cfind(const list_t* lst, const void* value,
+                         int (*predicate)(const void* data1, const void* data2));
+// Returns the number of elements equal to 'value', through the index when possible.
+int lst_count(const list_t* lst, const void* value, int (*predicate)(const void* data1, const void* data2));
+// Adds a new element at the end of the list container, if the element already exists elsewhere in the list, it updates
+// the element without adding new. Lookup goes through the index when possible.
+int lst_push_back_unique(list_t* lst, const void* value, void* src,
+                         int (*predicate)(const void* data1, const void* data2),
+                         void (*copy)(const void* src_data, void* dst_data), void* (*ctor_copy)(const void* src_data));
+////////////////////////////////////////////////////////////////////////////
 // Algorithms
 ////////////////////////////////////////////////////////////////////////////
 // Applies function fn to each of the elements in the range [first,last). Unary function that accepts an element in the
 // range as argument. Return: Its return value, if any, is ignored.
 int list_for_each(dlist_t* lst, int (*fn)(void* data));
 int list_for_each_extra(dlist_t* lst, int (*fn)(void* data), int count, ...);
+// Same as list_for_each, with 'ctx' passed through to every call of fn. Preferred over the *_extra forms, which are
+// limited to 6 arguments and call fn through a cast function pointer.
+int list_for_each_ctx(dlist_t* lst, int (*fn)(void* data, void* ctx), void* ctx);
 // Test if any element in range fulfills condition. Unary function that accepts an element in the range as argument and
 // returns a value convertible to bool. Returns true if pred returns true for any of the elements in the range
 // [first,last), and false otherwise. If [first,last) is an empty range, the function returns false.
 int list_any_of(dlist_t* lst, int (*fn)(void* data));
 int list_any_of_extra(dlist_t* lst, int (*fn)(void* data), int count, ...);
 int list_cany_of_extra(const dlist_t* lst, int (*fn)(void* data), int count, ...);
+int list_any_of_ctx(dlist_t* lst, int (*fn)(void* data, void* ctx), void* ctx);
+int list_cany_of_ctx(const dlist_t* lst, int (*fn)(void* data, void* ctx), void* ctx);
 // Test condition on all elements in range. Unary function that accepts an element in the range as argument and returns
 // a value convertible to bool. Returns true if pred returns true for all the elements in the range [first,last) or if
 // the range is empty, and false otherwise.
 int list_all_of(dlist_t* lst, int (*fn)(void* data));
 int list_all_of_extra(dlist_t* lst, int (*fn)(void* data), int count, ...);
+int list_all_of_ctx(dlist_t* lst, int (*fn)(void* data, void* ctx), void* ctx);
 // Test if no elements fulfill condition. Unary function that accepts an element in the range as argument and returns a
 // value convertible to bool. Returns true if pred returns false for all the elements in the range [first,last) or if
 // the range is empty, and false otherwise.
 int list_none_of(dlist_t* lst, int (*fn)(void* data));
 int list_none_of_extra(dlist_t* lst, int (*fn)(void* data), int count, ...);
+int list_none_of_ctx(dlist_t* lst, int (*fn)(void* data, void* ctx), void* ctx);
 // Returns the number of hops from first to last.
 int list_distance(const dlist_t* first1, const dlist_t* last1);
 // Compares the elements in the range [first1,last1) with those in the range beginning at first2, and returns true if
-// all of the elements in both ranges match, even in a different order.
+// all of the elements in both ranges match, even in a different order. Quadratic in the number of elements, prefer
+// list_is_permutation_hash or list_is_permutation_cmp for long lists.
 int list_is_permutation(const dlist_t* first1, const dlist_t* first2,
                         int (*predicate)(const void* data1, const void* data2));
+// Same as list_is_permutation in expected linear time. Elements equal under 'predicate' must have equal hashes. Returns
+// -1 if memory runs out.
+int list_is_permutation_hash(const dlist_t* first1, const dlist_t* first2, size_t (*hash)(const void* data),
+                             int (*predicate)(const void* data1, const void* data2));
+// Same as list_is_permutation in O(N log N), by sorting the elements with 'compare' (see list_sort). Returns -1 if
+// memory runs out.
+int list_is_permutation_cmp(const dlist_t* first1, const dlist_t* first2,
+                            int (*compare)(const void* data1, const void* data2));
 // Assign content. Assigns new contents to the container, replacing its current contents, and modifying its size
 // accordingly.
 int list_copy(const dlist_t* src_lst, dlist_t** dst_lst, void* (*ctor)(size_t count), void (*dtor)(void* data),
@@ -125,6 +301,55 @@ const uint8_t* transform_data_to_lst_x(const uint8_t* data, size_t* data_sz, dli
                                        const uint8_t* (*functor)(const uint8_t* data, size_t* data_sz,
                                                                  size_t number_elements, ...),
                                        size_t number_elements, ...);
+// Record stream: for every element a little-endian uint64 byte count, then the element bytes, zero padded to a multiple
+// of LIST_RECORD_ALIGN so every record starts aligned. 'view' returns the bytes of an element and stores their count in
+// '*size'.
+// Returns the number of bytes transform_lst_to_buffer writes for the list.
+size_t transform_lst_size(const dlist_t* lst, const void* (*view)(const void* data, size_t* size));
+// Serializes the list into one buffer allocated after a sizing pass. '*data' receives the buffer (release with free)
+// and '*data_sz' its size. An empty list gives a null buffer of size 0. Returns 0 on success.
+int transform_lst_to_buffer(const dlist_t* lst, uint8_t** data, size_t* data_sz,
+                            const void* (*view)(const void* data, size_t* size));
+// Same record stream as transform_lst_to_buffer without copying the element bytes: returns a scatter/gather array for
+// writev, the element entries pointing into the elements themselves, and stores its length in '*iov_count'. The array
+// owns the prefixes and is released with free; it stays valid as long as the elements are not changed. writev takes at
+// most IOV_MAX entries per call; include <sys/uio.h> to read the entries. Returns null on failure or for an empty list.
+struct iovec* transform_lst_to_iovec(const dlist_t* lst, size_t* iov_count,
+                                     const void* (*view)(const void* data, size_t* size));
+// Appends the records of a stream written by transform_lst_to_buffer to the list. 'make' builds an element from the
+// bytes of a record; when null, the bytes are copied into a new allocation. Returns 0 on success and -1 on a truncated
+// stream or when memory runs out, the records read so far are kept.
+int transform_buffer_to_lst(const uint8_t* data, size_t data_sz, dlist_t** lst,
+                            void* (*make)(const void* bytes, size_t size));
+
+// Incremental decoder of the record stream of transform_lst_to_buffer. It is fed chunks of any size as they arrive and
+// appends every completed record to the list; a record cut by a chunk boundary is kept until the rest arrives. Only
+// such records are copied, so memory use is bounded by the largest record.
+typedef struct list_decoder_t {
+  dlist_t** lst;
+  dlist_t* last;  // Last node of the list
+  void* (*make)(const void* bytes, size_t size);
+  size_t max_record;         // Largest accepted record, 0 for no limit
+  uint8_t prefix[8];         // Byte count of the current record
+  size_t prefix_len;         // Bytes of the prefix received, 8 while receiving the record bytes
+  uint64_t size;             // Byte count of the current record
+  uint8_t* buffer;           // Record bytes received so far
+  size_t buffer_len;
+  size_t buffer_capacity;
+  size_t pad;                // Padding bytes still to skip
+  int error;
+} list_decoder_t;
+// Initialize decoder appending to 'lst'. 'make' builds an element from the bytes of a record; when null, the bytes are
+// copied into a new allocation. Records larger than 'max_record' bytes are rejected, 0 accepts any size. The list must
+// not be changed by anything else until list_decoder_finish.
+void list_decoder_init(list_decoder_t* decoder, dlist_t** lst, void* (*make)(const void* bytes, size_t size),
+                       size_t max_record);
+// Decode a chunk. Returns the number of elements appended to the list, or -1 on a rejected record or when memory runs
+// out; the decoder then refuses further chunks.
+int list_decoder_feed(list_decoder_t* decoder, const uint8_t* data, size_t data_sz);
+// Releases the decoder. Returns 0 if the stream ended on a record boundary and -1 if a record is incomplete or an
+// error occurred.
+int list_decoder_finish(list_decoder_t* decoder);
 
 #ifdef __cplusplus
 }
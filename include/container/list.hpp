@@ -0,0 +1,412 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#ifndef _LIST_HPP
+#define _LIST_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "container/list.h"
+
+namespace clc {
+
+// Node of clc::list. It is a dlist_t whose 'data' points at the value stored right after the links, so one allocation
+// holds both and the chain can be read by the list.h functions.
+template <class T>
+struct list_node : dlist_t {
+  T value;
+
+  template <class... Args>
+  explicit list_node(Args&&... args) : dlist_t(), value(std::forward<Args>(args)...) {
+    data = &value;
+  }
+};
+
+// Typed doubly linked list over the dlist_t node layout. Nodes come from 'Alloc' rebound to list_node<T>. Algorithms
+// take templated predicates and comparators that the compiler can inline, with the standard library conventions:
+// predicates return true for a match and comparators are "less than". Requires C++11.
+template <class T, class Alloc = std::allocator<T>>
+class list {
+  using node_type = list_node<T>;
+  using node_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<node_type>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
+ public:
+  using value_type = T;
+  using allocator_type = Alloc;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+
+  // Bidirectional iterator. End is a null node. Decrementing an end iterator returned by end() reads the tail of that
+  // list, so like std::list that iterator is invalidated by swap. An iterator that reached the end by incrementing
+  // remembers the node it left and follows it to the current end of its chain, so element iterators stay valid across
+  // swap and move as long as that node is not erased.
+  template <bool Const>
+  class basic_iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = typename std::conditional<Const, const T*, T*>::type;
+    using reference = typename std::conditional<Const, const T&, T&>::type;
+
+    basic_iterator() = default;
+    // Iterator to const_iterator
+    template <bool C = Const, class = typename std::enable_if<C>::type>
+    basic_iterator(const basic_iterator<false>& other) : node_(other.node_), last_(other.last_), tail_(other.tail_) {}
+
+    reference operator*() const { return list::value_of(node_); }
+    pointer operator->() const { return &list::value_of(node_); }
+    basic_iterator& operator++() {
+      last_ = node_;
+      node_ = node_->next;
+      return *this;
+    }
+    basic_iterator operator++(int) {
+      basic_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    basic_iterator& operator--() {
+      if (node_) {
+        node_ = node_->prev;
+        return *this;
+      }
+      dlist_t* last = last_ ? last_ : *tail_;
+      while (last && last->next) last = last->next;
+      node_ = last;
+      return *this;
+    }
+    basic_iterator operator--(int) {
+      basic_iterator tmp = *this;
+      --*this;
+      return tmp;
+    }
+    friend bool operator==(const basic_iterator& a, const basic_iterator& b) { return a.node_ == b.node_; }
+    friend bool operator!=(const basic_iterator& a, const basic_iterator& b) { return a.node_ != b.node_; }
+
+   private:
+    friend class list;
+    friend class basic_iterator<!Const>;
+    basic_iterator(dlist_t* node, dlist_t* const* tail) : node_(node), tail_(tail) {}
+
+    dlist_t* node_ = nullptr;
+    dlist_t* last_ = nullptr;  // Node left by the increment that reached the end
+    dlist_t* const* tail_ = nullptr;
+  };
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Construction
+  ////////////////////////////////////////////////////////////////////////////
+  list() = default;
+  explicit list(const Alloc& alloc) : alloc_(alloc) {}
+  // Filling constructors delegate, so the destructor frees the nodes already built if an element constructor throws
+  list(std::initializer_list<T> init, const Alloc& alloc = Alloc()) : list(alloc) {
+    for (const T& value : init) emplace_back(value);
+  }
+  list(const list& other) : list(allocator_type(node_traits::select_on_container_copy_construction(other.alloc_))) {
+    for (const T& value : other) emplace_back(value);
+  }
+  list(list&& other) noexcept : alloc_(std::move(other.alloc_)) { steal(other); }
+  ~list() { clear(); }
+
+  list& operator=(const list& other) {
+    if (this == &other) return *this;
+    clear();
+    if (node_traits::propagate_on_container_copy_assignment::value) alloc_ = other.alloc_;
+    for (const T& value : other) emplace_back(value);
+    return *this;
+  }
+  list& operator=(list&& other) noexcept(node_traits::propagate_on_container_move_assignment::value) {
+    if (this == &other) return *this;
+    clear();
+    if (node_traits::propagate_on_container_move_assignment::value) {
+      alloc_ = std::move(other.alloc_);
+      steal(other);
+    } else if (alloc_ == other.alloc_) {
+      steal(other);
+    } else {
+      // Nodes of another allocator cannot be adopted, the values are moved one by one
+      for (T& value : other) emplace_back(std::move(value));
+      other.clear();
+    }
+    return *this;
+  }
+  allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Access
+  ////////////////////////////////////////////////////////////////////////////
+  iterator begin() noexcept { return iterator(head_, &tail_); }
+  const_iterator begin() const noexcept { return const_iterator(head_, &tail_); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  iterator end() noexcept { return iterator(nullptr, &tail_); }
+  const_iterator end() const noexcept { return const_iterator(nullptr, &tail_); }
+  const_iterator cend() const noexcept { return end(); }
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+  T& front() { return *begin(); }
+  const T& front() const { return *begin(); }
+  T& back() { return value_of(tail_); }
+  const T& back() const { return value_of(tail_); }
+  size_type size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+  // The chain as a bare list for the read-only list.h functions, every 'data' points at a T. The nodes stay owned by
+  // this list and must not be modified or freed through the C API.
+  const dlist_t* c_list() const noexcept { return head_; }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Modifiers
+  ////////////////////////////////////////////////////////////////////////////
+  template <class... Args>
+  T& emplace_back(Args&&... args) {
+    return value_of(link(nullptr, create(std::forward<Args>(args)...)));
+  }
+  template <class... Args>
+  T& emplace_front(Args&&... args) {
+    return value_of(link(head_, create(std::forward<Args>(args)...)));
+  }
+  // Construct an element in place before 'pos'
+  template <class... Args>
+  iterator emplace(const_iterator pos, Args&&... args) {
+    return iterator(link(pos.node_, create(std::forward<Args>(args)...)), &tail_);
+  }
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+  void push_front(const T& value) { emplace_front(value); }
+  void push_front(T&& value) { emplace_front(std::move(value)); }
+  iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+  iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+  void pop_front() { destroy(unlink(head_)); }
+  void pop_back() { destroy(unlink(tail_)); }
+  // Erase element. Returns the iterator following 'pos'.
+  iterator erase(const_iterator pos) {
+    dlist_t* next = pos.node_->next;
+    destroy(unlink(pos.node_));
+    return iterator(next, &tail_);
+  }
+  iterator erase(const_iterator first, const_iterator last) {
+    while (first != last) first = erase(first);
+    return iterator(last.node_, &tail_);
+  }
+  void clear() noexcept {
+    dlist_t* cur = head_;
+    while (cur) {
+      dlist_t* tmp = cur;
+      // Set next
+      cur = cur->next;
+      destroy(tmp);
+    }
+    head_ = tail_ = nullptr;
+    size_ = 0;
+  }
+  void swap(list& other) noexcept {
+    using std::swap;
+    if (node_traits::propagate_on_container_swap::value) swap(alloc_, other.alloc_);
+    swap(head_, other.head_);
+    swap(tail_, other.tail_);
+    swap(size_, other.size_);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Algorithms
+  ////////////////////////////////////////////////////////////////////////////
+  // Searches the list for the first element for which 'pred' returns true, returns it or end().
+  template <class Pred>
+  iterator find_if(Pred pred) {
+    dlist_t* cur = head_;
+    while (cur && !pred(value_of(cur))) cur = cur->next;
+    return iterator(cur, &tail_);
+  }
+  template <class Pred>
+  const_iterator find_if(Pred pred) const {
+    return const_cast<list*>(this)->find_if(pred);
+  }
+  iterator find(const T& value) {
+    return find_if([&value](const T& data) { return data == value; });
+  }
+  const_iterator find(const T& value) const {
+    return find_if([&value](const T& data) { return data == value; });
+  }
+  // Returns the number of elements for which 'pred' returns true.
+  template <class Pred>
+  size_type count_if(Pred pred) const {
+    size_type count = 0;
+    for (const dlist_t* cur = head_; cur; cur = cur->next) count += pred(value_of(cur)) ? 1 : 0;
+    return count;
+  }
+  size_type count(const T& value) const {
+    return count_if([&value](const T& data) { return data == value; });
+  }
+  // Erase in a single pass the elements for which 'pred' returns true. Returns the number of removed elements.
+  template <class Pred>
+  size_type remove_if(Pred pred) {
+    size_type count = 0;
+    dlist_t* cur = head_;
+    while (cur) {
+      dlist_t* tmp = cur;
+      // Set next
+      cur = cur->next;
+      if (!pred(value_of(tmp))) continue;
+      destroy(unlink(tmp));
+      count++;
+    }
+    return count;
+  }
+  size_type remove(const T& value) {
+    return remove_if([&value](const T& data) { return data == value; });
+  }
+  // Sort elements in container. Stable, in-place merge sort as list_sort, relinking the nodes; values are not moved.
+  template <class Compare>
+  void sort(Compare less) {
+    dlist_t* runs[64] = {nullptr};
+    dlist_t* cur = head_;
+    std::size_t i = 0;
+    while (cur) {
+      dlist_t* run = cur;
+      // Set next
+      cur = cur->next;
+      run->next = nullptr;
+      for (i = 0; runs[i]; i++) {
+        run = merge_chains(runs[i], run, less);
+        runs[i] = nullptr;
+      }
+      runs[i] = run;
+    }
+    dlist_t* first = nullptr;
+    for (i = 0; i < 64; i++)
+      if (runs[i]) first = merge_chains(runs[i], first, less);
+    // Restore the back links
+    dlist_t* prev = nullptr;
+    for (cur = first; cur; cur = cur->next) {
+      cur->prev = prev;
+      prev = cur;
+    }
+    head_ = first;
+    tail_ = prev;
+  }
+  void sort() {
+    sort([](const T& a, const T& b) { return a < b; });
+  }
+
+ private:
+  // The value sits at a fixed offset from the links, reading it there saves the load of 'data'
+  static T& value_of(dlist_t* node) noexcept { return static_cast<node_type*>(node)->value; }
+  static const T& value_of(const dlist_t* node) noexcept { return static_cast<const node_type*>(node)->value; }
+  template <class... Args>
+  dlist_t* create(Args&&... args) {
+    node_type* node = node_traits::allocate(alloc_, 1);
+    try {
+      node_traits::construct(alloc_, node, std::forward<Args>(args)...);
+    } catch (...) {
+      node_traits::deallocate(alloc_, node, 1);
+      throw;
+    }
+    return node;
+  }
+  void destroy(dlist_t* link) noexcept {
+    node_type* node = static_cast<node_type*>(link);
+    node_traits::destroy(alloc_, node);
+    node_traits::deallocate(alloc_, node, 1);
+  }
+  // Link 'node' before 'pos', at the end when 'pos' is null
+  dlist_t* link(dlist_t* pos, dlist_t* node) noexcept {
+    node->next = pos;
+    node->prev = pos ? pos->prev : tail_;
+    if (node->prev)
+      node->prev->next = node;
+    else
+      head_ = node;
+    if (pos)
+      pos->prev = node;
+    else
+      tail_ = node;
+    size_++;
+    return node;
+  }
+  dlist_t* unlink(dlist_t* node) noexcept {
+    if (node->prev)
+      node->prev->next = node->next;
+    else
+      head_ = node->next;
+    if (node->next)
+      node->next->prev = node->prev;
+    else
+      tail_ = node->prev;
+    size_--;
+    return node;
+  }
+  void steal(list& other) noexcept {
+    head_ = other.head_;
+    tail_ = other.tail_;
+    size_ = other.size_;
+    other.head_ = other.tail_ = nullptr;
+    other.size_ = 0;
+  }
+  // Merge two sorted chains linked through 'next', elements of 'first1' go first among equals
+  template <class Compare>
+  static dlist_t* merge_chains(dlist_t* first1, dlist_t* first2, Compare& less) {
+    dlist_t* first = nullptr;
+    dlist_t** link = &first;
+    while (first1 && first2) {
+      if (less(value_of(first2), value_of(first1))) {
+        *link = first2;
+        first2 = first2->next;
+      } else {
+        *link = first1;
+        first1 = first1->next;
+      }
+      link = &(*link)->next;
+    }
+    *link = first1 ? first1 : first2;
+    return first;
+  }
+
+  dlist_t* head_ = nullptr;
+  dlist_t* tail_ = nullptr;
+  size_type size_ = 0;
+  node_allocator alloc_;
+};
+
+template <class T, class Alloc>
+void swap(list<T, Alloc>& a, list<T, Alloc>& b) noexcept {
+  a.swap(b);
+}
+
+}  // namespace clc
+
+#endif  //_LIST_HPP
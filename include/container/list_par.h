@@ -0,0 +1,62 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#ifndef _LIST_PAR_H
+#define _LIST_PAR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "container/list.h"
+#include "container/thread_pool.h"
+
+// Number of consecutive nodes the list is cut into before the pieces are grouped into tasks
+#ifndef LIST_PAR_GRAIN
+#define LIST_PAR_GRAIN 256
+#endif
+
+////////////////////////////////////////////////////////////////////////////
+// Parallel algorithms
+////////////////////////////////////////////////////////////////////////////
+// The list is walked once to cut it into segments, which are then processed by the workers of 'pool'. Functions and
+// predicates must be safe to call concurrently on different elements, and the list must not change meanwhile. With a
+// null pool the sequential algorithm runs instead.
+
+// Applies function fn to each of the elements, in no particular order.
+int list_par_for_each(thread_pool_t* pool, dlist_t* lst, int (*fn)(void* data));
+// Returns true if fn returns true for any of the elements. Workers stop as soon as one of them finds such an element.
+int list_par_any_of(thread_pool_t* pool, dlist_t* lst, int (*fn)(void* data));
+// Returns true if fn returns true for all the elements. Workers stop as soon as one of them finds a counterexample.
+int list_par_all_of(thread_pool_t* pool, dlist_t* lst, int (*fn)(void* data));
+// Returns the number of elements for which predicate returns 0.
+int list_par_count(thread_pool_t* pool, const dlist_t* lst, const void* value,
+                   int (*predicate)(const void* data1, const void* data2));
+// Searches the list for the first occurrence, like list_find. Segments after the first matching one are abandoned,
+// segments before it run to completion, so the result is the same as with list_find.
+dlist_t* list_par_find(thread_pool_t* pool, dlist_t* lst, const void* value,
+                       int (*predicate)(const void* data1, const void* data2));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  //_LIST_PAR_H
@@ -0,0 +1,52 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#ifndef _LIST_STATS_H
+#define _LIST_STATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+// Counters of the list layer (list.c), kept per thread when the library is built with LIST_STATS defined. Without it the
+// instrumentation compiles to nothing and list_stats_snapshot reports it as unavailable.
+typedef struct list_stats_t {
+  uint64_t nodes_traversed;  // Hops from one node to the next or previous one
+  uint64_t predicate_calls;
+  uint64_t deleter_calls;  // Calls of user deleters, batched deleters count once per batch
+  uint64_t node_allocs;
+  uint64_t node_frees;
+  uint64_t rewinds;  // list_front/list_cfront calls that had to walk back to the first node
+} list_stats_t;
+
+// Copy the counters of the calling thread. Returns 0, or -1 with zeroed counters if the library is built without
+// LIST_STATS.
+int list_stats_snapshot(list_stats_t* stats);
+// Zero the counters of the calling thread.
+void list_stats_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  //_LIST_STATS_H
@@ -0,0 +1,104 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#ifndef _PLIST_H
+#define _PLIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "container/list.h"
+
+// Persistent list file: a header followed by nodes linked through byte offsets from the start of the file instead of
+// pointers, so the file is used in place once mapped. Opening a file only checks its header and does not depend on the
+// number of elements. Numbers are stored in host byte order, files from a host of the other order are rejected.
+#define PLIST_MAGIC "CLCPLST"
+#define PLIST_VERSION 1
+#define PLIST_ALIGN 8
+
+typedef struct plist_header_t {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;  // 0x01020304 as written by the host
+  uint64_t count;       // Number of elements
+  uint64_t first;       // Offset of the first node, 0 if empty
+  uint64_t last;        // Offset of the last node, 0 if empty
+  uint64_t file_sz;
+  uint64_t reserved[2];
+} plist_header_t;
+
+// Node, followed by 'size' element bytes padded to PLIST_ALIGN. 'next' and 'prev' are 0 at the ends
+typedef struct plist_node_t {
+  uint64_t next;
+  uint64_t prev;
+  uint64_t size;
+} plist_node_t;
+
+// Opened list file, mapped read-only
+typedef struct plist_t {
+  const uint8_t* base;
+  size_t size;
+} plist_t;
+
+////////////////////////////////////////////////////////////////////////////
+// Persistent list
+////////////////////////////////////////////////////////////////////////////
+// Writes the list to file 'path'. 'view' returns the bytes of an element and stores their count in '*size'. Returns 0
+// on success.
+int plist_write(const char* path, const dlist_t* lst, const void* (*view)(const void* data, size_t* size));
+// Maps file 'path' read-only. Returns 0 on success and -1 if the file cannot be mapped, is not a list file or has an
+// element count or ends that do not fit the file.
+int plist_open(plist_t* plst, const char* path);
+// Unmaps the file. Pointers into it are invalid afterwards.
+void plist_close(plist_t* plst);
+// Returns the number of elements.
+size_t plist_size(const plist_t* plst);
+// Test whether container is empty.
+int plist_empty(const plist_t* plst);
+// Returns the first node, or null if the list is empty.
+const plist_node_t* plist_front(const plist_t* plst);
+// Returns the last node, or null if the list is empty.
+const plist_node_t* plist_back(const plist_t* plst);
+// Returns the node after 'node', or null at the end. Offsets leading out of the file end the list as well.
+const plist_node_t* plist_next(const plist_t* plst, const plist_node_t* node);
+// Returns the node before 'node', or null at the beginning.
+const plist_node_t* plist_prev(const plist_t* plst, const plist_node_t* node);
+// Returns the element bytes of 'node' and stores their count in '*size' when not null.
+const void* plist_data(const plist_node_t* node, size_t* size);
+
+// Algorithms, elements are passed as pointers to their bytes
+// Applies function fn to each of the elements. Its return value is ignored.
+void plist_for_each(const plist_t* plst, int (*fn)(const void* data, void* ctx), void* ctx);
+// Returns the number of elements equal to 'value', or -1 if 'plst' or 'predicate' is null.
+int plist_count(const plist_t* plst, const void* value, int (*predicate)(const void* data1, const void* data2));
+// Searches the list for the first element equal to 'value', returns its node or null.
+const plist_node_t* plist_find(const plist_t* plst, const void* value,
+                               int (*predicate)(const void* data1, const void* data2));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  //_PLIST_H
@@ -0,0 +1,94 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#ifndef _SKIPLIST_H
+#define _SKIPLIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+#define SKIPLIST_MAX_LEVEL 32
+
+// Skip list node. 'data' is the element; level 0 links every node in order and each higher level skips over a quarter
+// of the nodes of the level below. 'span' counts the level 0 steps a link covers, which gives ranks in O(log N).
+typedef struct skiplist_node_t {
+  void* data;
+  size_t level;
+  struct skiplist_link_t {
+    struct skiplist_node_t* next;
+    size_t span;
+  } links[];
+} skiplist_node_t;
+
+// Ordered container of void* elements. 'compare' returns a negative, zero or positive value as for qsort; in lookups
+// the element comes first and 'value' second. Equal elements are kept in insertion order.
+typedef struct skiplist_t skiplist_t;
+
+////////////////////////////////////////////////////////////////////////////
+// Skip list
+////////////////////////////////////////////////////////////////////////////
+// Construct list. Returns null on failure.
+skiplist_t* skiplist_create(int (*compare)(const void* data1, const void* data2));
+// Destroy list. Calls 'deleter' for every element, free when it is null.
+void skiplist_destroy(skiplist_t* sl, void (*deleter)(void* data));
+// Insert element in order, after the elements equal to it, in O(log N). Returns its node, or null on failure.
+skiplist_node_t* skiplist_insert(skiplist_t* sl, void* data);
+// Searches the list for the first element equal to 'value', returns its node or null.
+skiplist_node_t* skiplist_find(const skiplist_t* sl, const void* value);
+// Erase the first element equal to 'value', calling 'deleter' for it (free when it is null). Returns 1 if an element
+// was erased and 0 otherwise.
+int skiplist_erase(skiplist_t* sl, const void* value, void (*deleter)(void* data));
+// Delete first element, calling 'deleter' for it (free when it is null).
+void skiplist_pop_front(skiplist_t* sl, void (*deleter)(void* data));
+// Returns the node of the first element not less than 'value', or null if there is none.
+skiplist_node_t* skiplist_lower_bound(const skiplist_t* sl, const void* value);
+// Returns the node of the first element greater than 'value', or null if there is none.
+skiplist_node_t* skiplist_upper_bound(const skiplist_t* sl, const void* value);
+// Access element by rank. Returns the node at position 'pos' in order, or null when out of range.
+skiplist_node_t* skiplist_at(const skiplist_t* sl, size_t pos);
+// Returns the number of elements less than 'value', i.e. the position of its lower bound.
+size_t skiplist_rank(const skiplist_t* sl, const void* value);
+// Access first element, or null if the list is empty.
+skiplist_node_t* skiplist_front(const skiplist_t* sl);
+// Returns the node following 'node' in order, or null.
+skiplist_node_t* skiplist_next(const skiplist_node_t* node);
+// Applies function fn, in order, to the elements not less than 'first' and less than 'last'. A null 'first' starts at
+// the front and a null 'last' runs to the end. fn must not modify the list.
+int skiplist_for_range(const skiplist_t* sl, const void* first, const void* last, int (*fn)(void* data, void* ctx),
+                       void* ctx);
+// Same as list_traverse over the nodes in [first,last), a null 'last' runs to the end.
+void skiplist_traverse(const skiplist_node_t* first, const skiplist_node_t* last,
+                       void (*fn)(const skiplist_node_t* node, void** data), void** data);
+// Removes all elements, calling 'deleter' for each of them (free when it is null).
+void skiplist_clear(skiplist_t* sl, void (*deleter)(void* data));
+// Return size. Returns the number of elements in the list.
+size_t skiplist_size(const skiplist_t* sl);
+// Test whether container is empty.
+int skiplist_empty(const skiplist_t* sl);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  //_SKIPLIST_H
@@ -0,0 +1,53 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#ifndef _THREAD_POOL_H
+#define _THREAD_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Reusable pool of worker threads
+typedef struct thread_pool_t thread_pool_t;
+
+////////////////////////////////////////////////////////////////////////////
+// Thread pool
+////////////////////////////////////////////////////////////////////////////
+// Construct pool. Starts 'threads' workers, which sleep until work is submitted. Returns null on failure.
+thread_pool_t* thread_pool_create(size_t threads);
+// Destroy pool. Stops and joins the workers.
+void thread_pool_destroy(thread_pool_t* pool);
+// Returns the number of workers.
+size_t thread_pool_size(const thread_pool_t* pool);
+// Runs fn(arg, task) for every task in [0,count) and waits for all of them. Each worker starts on its own contiguous
+// share of the tasks, taken in ascending order, and an idle worker steals the upper half of the largest remaining
+// share. Concurrent calls are serialized. Returns 0 on success.
+int thread_pool_run(thread_pool_t* pool, void (*fn)(void* arg, size_t task), void* arg, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  //_THREAD_POOL_H
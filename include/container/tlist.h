@@ -0,0 +1,205 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#ifndef _TLIST_H
+#define _TLIST_H
+
+#include <stddef.h>
+#include <stdlib.h>
+
+// Typed doubly linked list generator. CLC_DLIST_DEFINE(name, T, cmp) declares name_t, a list whose nodes hold a T
+// inline, and static inline functions name_init, name_clear, name_push_back, name_push_front, name_erase,
+// name_pop_front, name_pop_back, name_find, name_count, name_sort and name_for_each. An element takes one allocation
+// instead of a node plus a payload, and 'cmp' is called directly so the compiler can inline it. 'cmp' is a function or
+// function-like macro taking two const T* and returning a negative, zero or positive value as for qsort; find and count
+// match where it returns 0, as the list.h predicates. For example:
+//
+//   static inline int cmp_i64(const int64_t* a, const int64_t* b) { return (*a > *b) - (*a < *b); }
+//   CLC_DLIST_DEFINE(i64list, int64_t, cmp_i64)
+//
+//   i64list_t lst;
+//   i64list_init(&lst);
+//   i64list_push_back(&lst, 42);
+
+#define CLC_DLIST_DEFINE(name, T, cmp)                                                                                 \
+  typedef struct name##_node_t {                                                                                       \
+    T data;                                                                                                            \
+    struct name##_node_t* next;                                                                                        \
+    struct name##_node_t* prev;                                                                                        \
+  } name##_node_t;                                                                                                     \
+                                                                                                                       \
+  typedef struct name##_t {                                                                                            \
+    name##_node_t* head;                                                                                               \
+    name##_node_t* tail;                                                                                               \
+    size_t size;                                                                                                       \
+  } name##_t;                                                                                                          \
+                                                                                                                       \
+  /* Construct list. Initializes an empty list. */                                                                     \
+  static inline void name##_init(name##_t* lst) {                                                                      \
+    lst->head = lst->tail = NULL;                                                                                      \
+    lst->size = 0;                                                                                                     \
+  }                                                                                                                    \
+  /* Removes all elements. Values are stored in the nodes, so there is no deleter. */                                  \
+  static inline void name##_clear(name##_t* lst) {                                                                     \
+    name##_node_t* cur = lst->head;                                                                                    \
+    while (cur) {                                                                                                      \
+      name##_node_t* tmp = cur;                                                                                        \
+      /* Set next */                                                                                                   \
+      cur = cur->next;                                                                                                 \
+      free(tmp);                                                                                                       \
+    }                                                                                                                  \
+    name##_init(lst);                                                                                                  \
+  }                                                                                                                    \
+  /* Add element at the end. Copies 'value' into a new node. Returns the node, or null on failure. */                  \
+  static inline name##_node_t* name##_push_back(name##_t* lst, T value) {                                              \
+    name##_node_t* node = (name##_node_t*)malloc(sizeof(name##_node_t));                                               \
+    if (!node) return NULL;                                                                                            \
+    node->data = value;                                                                                                \
+    node->next = NULL;                                                                                                 \
+    node->prev = lst->tail;                                                                                            \
+    if (lst->tail)                                                                                                     \
+      lst->tail->next = node;                                                                                          \
+    else                                                                                                               \
+      lst->head = node;                                                                                                \
+    lst->tail = node;                                                                                                  \
+    lst->size++;                                                                                                       \
+    return node;                                                                                                       \
+  }                                                                                                                    \
+  /* Insert element at beginning. Copies 'value' into a new node. Returns the node, or null on failure. */             \
+  static inline name##_node_t* name##_push_front(name##_t* lst, T value) {                                             \
+    name##_node_t* node = (name##_node_t*)malloc(sizeof(name##_node_t));                                               \
+    if (!node) return NULL;                                                                                            \
+    node->data = value;                                                                                                \
+    node->prev = NULL;                                                                                                 \
+    node->next = lst->head;                                                                                            \
+    if (lst->head)                                                                                                     \
+      lst->head->prev = node;                                                                                          \
+    else                                                                                                               \
+      lst->tail = node;                                                                                                \
+    lst->head = node;                                                                                                  \
+    lst->size++;                                                                                                       \
+    return node;                                                                                                       \
+  }                                                                                                                    \
+  /* Erase element. Unlinks and frees 'node'. */                                                                       \
+  static inline void name##_erase(name##_t* lst, name##_node_t* node) {                                                \
+    if (node->prev)                                                                                                    \
+      node->prev->next = node->next;                                                                                   \
+    else                                                                                                               \
+      lst->head = node->next;                                                                                          \
+    if (node->next)                                                                                                    \
+      node->next->prev = node->prev;                                                                                   \
+    else                                                                                                               \
+      lst->tail = node->prev;                                                                                          \
+    lst->size--;                                                                                                       \
+    free(node);                                                                                                        \
+  }                                                                                                                    \
+  /* Delete first element, copying its value to 'value' when not null. Returns 0, or -1 if the list is empty. */       \
+  static inline int name##_pop_front(name##_t* lst, T* value) {                                                        \
+    if (!lst->head) return -1;                                                                                         \
+    if (value) *value = lst->head->data;                                                                               \
+    name##_erase(lst, lst->head);                                                                                      \
+    return 0;                                                                                                          \
+  }                                                                                                                    \
+  /* Delete last element, copying its value to 'value' when not null. Returns 0, or -1 if the list is empty. */        \
+  static inline int name##_pop_back(name##_t* lst, T* value) {                                                         \
+    if (!lst->tail) return -1;                                                                                         \
+    if (value) *value = lst->tail->data;                                                                               \
+    name##_erase(lst, lst->tail);                                                                                      \
+    return 0;                                                                                                          \
+  }                                                                                                                    \
+  /* Searches the list for the first element equal to 'value', returns its node or null. */                            \
+  static inline name##_node_t* name##_find(const name##_t* lst, const T* value) {                                      \
+    name##_node_t* cur = lst->head;                                                                                    \
+    while (cur) {                                                                                                      \
+      if (0 == cmp(&cur->data, value)) return cur;                                                                     \
+      /* Set next */                                                                                                   \
+      cur = cur->next;                                                                                                 \
+    }                                                                                                                  \
+    return NULL;                                                                                                       \
+  }                                                                                                                    \
+  /* Returns the number of elements equal to 'value'. */                                                               \
+  static inline size_t name##_count(const name##_t* lst, const T* value) {                                             \
+    size_t count = 0;                                                                                                  \
+    const name##_node_t* cur = lst->head;                                                                              \
+    while (cur) {                                                                                                      \
+      count += 0 == cmp(&cur->data, value);                                                                            \
+      /* Set next */                                                                                                   \
+      cur = cur->next;                                                                                                 \
+    }                                                                                                                  \
+    return count;                                                                                                      \
+  }                                                                                                                    \
+  /* Merge two sorted chains linked through 'next', elements of 'first1' go first among equals. */                     \
+  static inline name##_node_t* name##_merge_chains(name##_node_t* first1, name##_node_t* first2) {                     \
+    name##_node_t* first = NULL;                                                                                       \
+    name##_node_t** link = &first;                                                                                     \
+    while (first1 && first2) {                                                                                         \
+      if (cmp(&first2->data, &first1->data) < 0) {                                                                     \
+        *link = first2;                                                                                                \
+        first2 = first2->next;                                                                                         \
+      } else {                                                                                                         \
+        *link = first1;                                                                                                \
+        first1 = first1->next;                                                                                         \
+      }                                                                                                                \
+      link = &(*link)->next;                                                                                           \
+    }                                                                                                                  \
+    *link = first1 ? first1 : first2;                                                                                  \
+    return first;                                                                                                      \
+  }                                                                                                                    \
+  /* Sort elements in container. Stable, in-place merge sort as list_sort, with 'cmp' inlined. */                      \
+  static inline void name##_sort(name##_t* lst) {                                                                      \
+    name##_node_t* runs[64] = {NULL};                                                                                  \
+    name##_node_t* cur = lst->head;                                                                                    \
+    size_t i = 0;                                                                                                      \
+    while (cur) {                                                                                                      \
+      name##_node_t* run = cur;                                                                                        \
+      /* Set next */                                                                                                   \
+      cur = cur->next;                                                                                                 \
+      run->next = NULL;                                                                                                \
+      for (i = 0; runs[i]; i++) {                                                                                      \
+        run = name##_merge_chains(runs[i], run);                                                                       \
+        runs[i] = NULL;                                                                                                \
+      }                                                                                                                \
+      runs[i] = run;                                                                                                   \
+    }                                                                                                                  \
+    name##_node_t* first = NULL;                                                                                       \
+    for (i = 0; i < 64; i++)                                                                                           \
+      if (runs[i]) first = name##_merge_chains(runs[i], first);                                                        \
+    /* Restore the back links */                                                                                       \
+    name##_node_t* prev = NULL;                                                                                        \
+    for (cur = first; cur; cur = cur->next) {                                                                          \
+      cur->prev = prev;                                                                                                \
+      prev = cur;                                                                                                      \
+    }                                                                                                                  \
+    lst->head = first;                                                                                                 \
+    lst->tail = prev;                                                                                                  \
+  }                                                                                                                    \
+  /* Applies function fn to each of the elements, in order. */                                                         \
+  static inline void name##_for_each(name##_t* lst, void (*fn)(T* data, void* ctx), void* ctx) {                       \
+    name##_node_t* cur = lst->head;                                                                                    \
+    while (cur) {                                                                                                      \
+      name##_node_t* tmp = cur;                                                                                        \
+      /* Set next */                                                                                                   \
+      cur = cur->next;                                                                                                 \
+      fn(&tmp->data, ctx);                                                                                             \
+    }                                                                                                                  \
+  }
+
+#endif  //_TLIST_H
@@ -0,0 +1,103 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#ifndef _ULIST_H
+#define _ULIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Number of elements per node. The default makes a node exactly four 64-byte cache lines.
+#ifndef ULIST_NODE_CAPACITY
+#define ULIST_NODE_CAPACITY 29
+#endif
+
+// Unrolled list node. Holds the elements [begin,end) of 'data'.
+typedef struct ulist_node_t {
+  struct ulist_node_t* next;
+  struct ulist_node_t* prev;
+  uint32_t begin;
+  uint32_t end;
+  void* data[ULIST_NODE_CAPACITY];
+} ulist_node_t;
+
+// Unrolled list. Elements are kept in chained arrays, so a scan touches about 1/ULIST_NODE_CAPACITY as many nodes as
+// with dlist_t.
+typedef struct ulist_t {
+  ulist_node_t* head;
+  ulist_node_t* tail;
+  size_t size;
+} ulist_t;
+
+////////////////////////////////////////////////////////////////////////////
+// Unrolled list
+////////////////////////////////////////////////////////////////////////////
+// Construct list. Initializes an empty list.
+void ulist_init(ulist_t* lst);
+// Add element at the end. Returns 0 on success.
+int ulist_push_back(ulist_t* lst, void* data);
+// Insert element at beginning. Returns 0 on success.
+int ulist_push_front(ulist_t* lst, void* data);
+// Delete first element. Removes the first element in the list container, effectively reducing its size by one.
+void ulist_pop_front(ulist_t* lst, void (*deleter)(void* data));
+// Delete last element. Removes the last element in the list container, effectively reducing the container size by one.
+void ulist_pop_back(ulist_t* lst, void (*deleter)(void* data));
+// Access first element. Returns the first element, or null if the list is empty.
+void* ulist_front(const ulist_t* lst);
+// Access last element. Returns the last element, or null if the list is empty.
+void* ulist_back(const ulist_t* lst);
+// Access element. Returns the element at position 'pos', or null if out of range.
+void* ulist_at(const ulist_t* lst, size_t pos);
+// Return size. Returns the number of elements in the list container.
+size_t ulist_size(const ulist_t* lst);
+// Test whether container is empty. Returns whether the list container is empty (i.e. whether its size is 0).
+int ulist_empty(const ulist_t* lst);
+// Removes all elements from the list container (which are destroyed), and leaving the container with a size of 0.
+void ulist_clear(ulist_t* lst, void (*deleter)(void* data));
+////////////////////////////////////////////////////////////////////////////
+// Algorithms
+////////////////////////////////////////////////////////////////////////////
+// Applies function fn to each of the elements. Its return value, if any, is ignored.
+int ulist_for_each(ulist_t* lst, int (*fn)(void* data));
+// Returns true if fn returns true for any of the elements, and false otherwise.
+int ulist_any_of(ulist_t* lst, int (*fn)(void* data));
+// Returns true if fn returns true for all the elements or if the list is empty, and false otherwise.
+int ulist_all_of(ulist_t* lst, int (*fn)(void* data));
+// Returns true if fn returns false for all the elements or if the list is empty, and false otherwise.
+int ulist_none_of(ulist_t* lst, int (*fn)(void* data));
+// Returns the number of elements for which predicate returns 0.
+int ulist_count(const ulist_t* lst, const void* value, int (*predicate)(const void* data1, const void* data2));
+// Searches the list for the first element for which predicate returns 0, and returns it, or null if there is none.
+void* ulist_find(const ulist_t* lst, const void* value, int (*predicate)(const void* data1, const void* data2));
+// Erase elements. Removes in a single pass all the elements for which predicate returns 0, calling 'deleter' for each
+// of them, and packs the remaining ones into as few nodes as possible. Returns the number of removed elements.
+int ulist_erase_if(ulist_t* lst, const void* value, int (*predicate)(const void* data1, const void* data2),
+                   void (*deleter)(void* data));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  //_ULIST_H
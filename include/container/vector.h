@@ -0,0 +1,130 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#ifndef _VECTOR_H
+#define _VECTOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Dynamic array. Elements of 'elem_sz' bytes are stored inline and contiguously, so scans walk memory in order instead
+// of chasing pointers. Algorithms follow list.h: callbacks and predicates receive a pointer to the element and
+// predicates return 0 for a match. Elements are owned by the vector storage, a deleter only releases what an element
+// refers to and nothing is freed when it is null.
+typedef struct vector_t {
+  void* data;
+  size_t size;
+  size_t capacity;
+  size_t elem_sz;
+} vector_t;
+
+////////////////////////////////////////////////////////////////////////////
+// Vector
+////////////////////////////////////////////////////////////////////////////
+// Construct vector. Initializes an empty vector of elements of 'elem_sz' bytes.
+void vector_init(vector_t* vec, size_t elem_sz);
+// Destroy vector. Calls 'deleter' for every element and releases the storage.
+void vector_destroy(vector_t* vec, void (*deleter)(void* data));
+// Request a change in capacity. Makes room for at least 'capacity' elements. Returns 0 on success.
+int vector_reserve(vector_t* vec, size_t capacity);
+// Add element at the end. Copies 'elem' after the last element in amortized constant time. 'elem' may point into the
+// vector, its value before the call is copied. Returns the stored element, or null on failure.
+void* vector_push_back(vector_t* vec, const void* elem);
+// Delete last element, calling 'deleter' for it.
+void vector_pop_back(vector_t* vec, void (*deleter)(void* data));
+// Insert element. Copies 'elem' before position 'pos' (at the end when 'pos' is the size), moving the following
+// elements. 'elem' may point into the vector, its value before the call is copied. Returns the stored element, or null
+// on failure.
+void* vector_insert(vector_t* vec, size_t pos, const void* elem);
+// Erase element. Removes the element at position 'pos', calling 'deleter' for it and moving the following elements.
+void vector_erase(vector_t* vec, size_t pos, void (*deleter)(void* data));
+// Access element. Returns the element at position 'pos', or null when out of range.
+void* vector_at(const vector_t* vec, size_t pos);
+// Access first element, or null if the vector is empty.
+void* vector_front(const vector_t* vec);
+// Access last element, or null if the vector is empty.
+void* vector_back(const vector_t* vec);
+// Return size. Returns the number of elements in the vector.
+size_t vector_size(const vector_t* vec);
+// Test whether container is empty.
+int vector_empty(const vector_t* vec);
+// Removes all elements, calling 'deleter' for each of them. The storage is kept.
+void vector_clear(vector_t* vec, void (*deleter)(void* data));
+
+////////////////////////////////////////////////////////////////////////////
+// Algorithms
+////////////////////////////////////////////////////////////////////////////
+// Applies function fn to each of the elements. Its return value is ignored. Returns 0.
+int vector_for_each(vector_t* vec, int (*fn)(void* data));
+// Same as vector_for_each, with 'ctx' passed through to every call of fn.
+int vector_for_each_ctx(vector_t* vec, int (*fn)(void* data, void* ctx), void* ctx);
+// Test if any element fulfills condition, i.e. fn returns 1. Returns false if the vector is empty.
+int vector_any_of(vector_t* vec, int (*fn)(void* data));
+// Test condition on all elements. Returns true if fn returns true for all elements or if the vector is empty.
+int vector_all_of(vector_t* vec, int (*fn)(void* data));
+// Test if no elements fulfill condition, i.e. fn returns 1 for none of them. Returns true if the vector is empty.
+int vector_none_of(vector_t* vec, int (*fn)(void* data));
+// Returns the number of elements equal to 'value'.
+int vector_count(const vector_t* vec, const void* value, int (*predicate)(const void* data1, const void* data2));
+// Searches the vector for the first element equal to 'value', returns it or null.
+void* vector_find(vector_t* vec, const void* value, int (*predicate)(const void* data1, const void* data2));
+const void* vector_cfind(const vector_t* vec, const void* value,
+                         int (*predicate)(const void* data1, const void* data2));
+// Erase elements. Removes in a single pass all the elements equal to 'value', calling 'deleter' for each of them and
+// keeping the order of the others. Returns the number of removed elements.
+int vector_erase_if(vector_t* vec, const void* value, int (*predicate)(const void* data1, const void* data2),
+                    void (*deleter)(void* data));
+// Sort elements with 'compare' (negative, zero or positive as for qsort). Not stable.
+int vector_sort(vector_t* vec, int (*compare)(const void* data1, const void* data2));
+
+////////////////////////////////////////////////////////////////////////////
+// Typed kernels
+////////////////////////////////////////////////////////////////////////////
+// Fast paths for vectors of int32_t, int64_t, float and double, vectorized with SSE2 or AVX2 as the CPU supports at run
+// time. The element size must match the type: find returns null, count 0 and min/max -1 otherwise. min/max return 0
+// and store the result, or -1 for an empty vector. NaN elements are skipped by min/max on every instruction set, unless
+// the first element is NaN; find and count never match NaN.
+int32_t* vector_find_i32(const vector_t* vec, int32_t value);
+size_t vector_count_i32(const vector_t* vec, int32_t value);
+int vector_min_i32(const vector_t* vec, int32_t* min);
+int vector_max_i32(const vector_t* vec, int32_t* max);
+int64_t* vector_find_i64(const vector_t* vec, int64_t value);
+size_t vector_count_i64(const vector_t* vec, int64_t value);
+int vector_min_i64(const vector_t* vec, int64_t* min);
+int vector_max_i64(const vector_t* vec, int64_t* max);
+float* vector_find_f32(const vector_t* vec, float value);
+size_t vector_count_f32(const vector_t* vec, float value);
+int vector_min_f32(const vector_t* vec, float* min);
+int vector_max_f32(const vector_t* vec, float* max);
+double* vector_find_f64(const vector_t* vec, double value);
+size_t vector_count_f64(const vector_t* vec, double value);
+int vector_min_f64(const vector_t* vec, double* min);
+int vector_max_f64(const vector_t* vec, double* max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  //_VECTOR_H
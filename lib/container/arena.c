@@ -0,0 +1,120 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <stdlib.h>
+#include <string.h>  // for 'memset'
+
+#include "container/arena.h"
+
+// Objects and the block header are kept aligned for any fundamental type
+#define ARENA_ALIGN 16
+#define ARENA_ROUND(sz) (((sz) + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1))
+////////////////////////////////////////////////////////////////////////////
+// Private functions
+////////////////////////////////////////////////////////////////////////////
+static void* arena_alloc_cb(void* ctx, size_t size);
+static void arena_free_cb(void* ctx, void* ptr);
+static void arena_reset_cb(void* ctx);
+// Make 'block' the block objects are carved from
+static void arena_use_block(arena_t* arena, arena_block_t* block) {
+  arena->current = block;
+  arena->cur = (uint8_t*)block + ARENA_ROUND(sizeof(arena_block_t));
+  arena->end = arena->cur + arena->elem_sz * arena->block_elems;
+}
+static void* arena_alloc_cb(void* ctx, size_t size) {
+  arena_t* arena = (arena_t*)ctx;
+  if (size > arena->elem_sz) return NULL;
+  return arena_alloc(arena);
+}
+static void arena_free_cb(void* ctx, void* ptr) { arena_free((arena_t*)ctx, ptr); }
+static void arena_reset_cb(void* ctx) { arena_reset((arena_t*)ctx); }
+////////////////////////////////////////////////////////////////////////////
+// Public functions
+////////////////////////////////////////////////////////////////////////////
+int arena_init(arena_t* arena, size_t elem_sz, size_t block_elems) {
+  if (!arena || !elem_sz || !block_elems) return -1;
+
+  memset(arena, 0, sizeof(*arena));
+  // Recycled objects keep the free list link inside
+  if (elem_sz < sizeof(void*)) elem_sz = sizeof(void*);
+  arena->elem_sz = ARENA_ROUND(elem_sz);
+  arena->block_elems = block_elems;
+  return 0;
+}
+void* arena_alloc(arena_t* arena) {
+  if (!arena) return NULL;
+
+  // Recycled object
+  if (arena->free_list) {
+    void* ptr = arena->free_list;
+    arena->free_list = *(void**)ptr;
+    return ptr;
+  }
+  // Move on to the next block, reusing the blocks kept by reset
+  if (arena->cur == arena->end) {
+    arena_block_t* block = arena->current ? arena->current->next : arena->blocks;
+    if (!block) {
+      block = (arena_block_t*)malloc(ARENA_ROUND(sizeof(arena_block_t)) + arena->elem_sz * arena->block_elems);
+      if (!block) return NULL;
+      block->next = NULL;
+      if (arena->current)
+        arena->current->next = block;
+      else
+        arena->blocks = block;
+    }
+    arena_use_block(arena, block);
+  }
+  void* ptr = arena->cur;
+  arena->cur += arena->elem_sz;
+  return ptr;
+}
+void arena_free(arena_t* arena, void* ptr) {
+  if (!arena || !ptr) return;
+  *(void**)ptr = arena->free_list;
+  arena->free_list = ptr;
+}
+void arena_reset(arena_t* arena) {
+  if (!arena) return;
+
+  arena->free_list = NULL;
+  if (arena->blocks) arena_use_block(arena, arena->blocks);
+}
+void arena_destroy(arena_t* arena) {
+  if (!arena) return;
+
+  arena_block_t* block = arena->blocks;
+  while (block) {
+    arena_block_t* tmp = block;
+    // Set next
+    block = block->next;
+    free(tmp);
+  }
+  arena->blocks = arena->current = NULL;
+  arena->cur = arena->end = NULL;
+  arena->free_list = NULL;
+}
+void arena_list_allocator(arena_t* arena, list_allocator_t* allocator) {
+  if (!allocator) return;
+  allocator->alloc = arena_alloc_cb;
+  allocator->free = arena_free_cb;
+  allocator->release = arena_reset_cb;
+  allocator->ctx = arena;
+}
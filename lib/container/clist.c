@@ -0,0 +1,315 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include "container/clist.h"
+
+// Locks are always taken from the front to the back. A node can only be unlinked while its predecessor and successor
+// are locked for writing, so a thread holding a node's neighbour may safely wait on its lock. Writers find their
+// position under read locks, pin the nodes with a reference so they cannot be freed, then relock them for writing and
+// check they are still adjacent. An unlinked node has a null next.
+typedef struct clist_node_t {
+  pthread_rwlock_t lock;
+  struct clist_node_t* next;
+  struct clist_node_t* prev;
+  void* data;
+  atomic_uint refs;  // One for the list while linked, one per pin
+} clist_node_t;
+
+struct clist_t {
+  clist_node_t head;  // Sentinels, never removed
+  clist_node_t tail;
+  atomic_size_t size;
+};
+////////////////////////////////////////////////////////////////////////////
+// Private functions
+////////////////////////////////////////////////////////////////////////////
+static clist_node_t* clist_node_create(void* data);
+static void clist_node_destroy(clist_node_t* node, void (*deleter)(void* data));
+static void clist_node_hold(clist_node_t* node);
+static void clist_node_release(clist_node_t* node);
+static void clist_link_before(clist_t* lst, clist_node_t* cur, clist_node_t* node);
+static clist_node_t* clist_lock_find(clist_t* lst, const void* value,
+                                     int (*predicate)(const void* data1, const void* data2), clist_node_t** pred);
+
+static clist_node_t* clist_node_create(void* data) {
+  clist_node_t* node = (clist_node_t*)malloc(sizeof(clist_node_t));
+  if (!node) return NULL;
+  if (pthread_rwlock_init(&node->lock, NULL)) {
+    free(node);
+    return NULL;
+  }
+  node->next = node->prev = NULL;
+  node->data = data;
+  atomic_init(&node->refs, 1);
+  return node;
+}
+static void clist_node_destroy(clist_node_t* node, void (*deleter)(void* data)) {
+  if (deleter)
+    deleter(node->data);
+  else
+    free(node->data);
+  clist_node_release(node);
+}
+// Pin a node. The caller holds a lock on the node or on a neighbour, so the node is linked
+static void clist_node_hold(clist_node_t* node) { atomic_fetch_add(&node->refs, 1); }
+// Drop a pin or, once unlinked, the reference of the list. The last one frees the node
+static void clist_node_release(clist_node_t* node) {
+  if (atomic_fetch_sub(&node->refs, 1) != 1) return;
+  pthread_rwlock_destroy(&node->lock);
+  free(node);
+}
+// Link 'node' before 'cur'. The caller holds 'cur' and its predecessor for writing
+static void clist_link_before(clist_t* lst, clist_node_t* cur, clist_node_t* node) {
+  clist_node_t* pred = cur->prev;
+  node->prev = pred;
+  node->next = cur;
+  pred->next = node;
+  cur->prev = node;
+  atomic_fetch_add(&lst->size, 1);
+}
+// Walk from the front with read locks until the first element equal to 'value', or the tail sentinel. Returns that
+// node with it and its predecessor '*pred' locked for writing
+static clist_node_t* clist_lock_find(clist_t* lst, const void* value,
+                                     int (*predicate)(const void* data1, const void* data2), clist_node_t** pred) {
+  for (;;) {
+    clist_node_t* prev = &lst->head;
+    pthread_rwlock_rdlock(&prev->lock);
+    clist_node_t* cur = prev->next;
+    pthread_rwlock_rdlock(&cur->lock);
+    while (cur != &lst->tail && 0 != predicate(cur->data, value)) {
+      pthread_rwlock_unlock(&prev->lock);
+      prev = cur;
+      // Set next
+      cur = cur->next;
+      pthread_rwlock_rdlock(&cur->lock);
+    }
+    // Read locks cannot be upgraded: pin the pair, relock it for writing and check nothing came in between
+    clist_node_hold(prev);
+    clist_node_hold(cur);
+    pthread_rwlock_unlock(&cur->lock);
+    pthread_rwlock_unlock(&prev->lock);
+    pthread_rwlock_wrlock(&prev->lock);
+    pthread_rwlock_wrlock(&cur->lock);
+    if (prev->next == cur) {
+      // Both are linked and locked, the pins are not the last references
+      clist_node_release(cur);
+      clist_node_release(prev);
+      *pred = prev;
+      return cur;
+    }
+    pthread_rwlock_unlock(&cur->lock);
+    pthread_rwlock_unlock(&prev->lock);
+    clist_node_release(cur);
+    clist_node_release(prev);
+  }
+}
+////////////////////////////////////////////////////////////////////////////
+// Public functions
+////////////////////////////////////////////////////////////////////////////
+clist_t* clist_create(void) {
+  clist_t* lst = (clist_t*)calloc(1, sizeof(clist_t));
+  if (!lst) return NULL;
+  if (pthread_rwlock_init(&lst->head.lock, NULL)) {
+    free(lst);
+    return NULL;
+  }
+  if (pthread_rwlock_init(&lst->tail.lock, NULL)) {
+    pthread_rwlock_destroy(&lst->head.lock);
+    free(lst);
+    return NULL;
+  }
+  lst->head.next = &lst->tail;
+  lst->tail.prev = &lst->head;
+  atomic_init(&lst->head.refs, 1);
+  atomic_init(&lst->tail.refs, 1);
+  atomic_init(&lst->size, 0);
+  return lst;
+}
+void clist_destroy(clist_t* lst, void (*deleter)(void* data)) {
+  if (!lst) return;
+
+  clist_node_t* cur = lst->head.next;
+  while (cur != &lst->tail) {
+    clist_node_t* tmp = cur;
+    // Set next
+    cur = cur->next;
+    clist_node_destroy(tmp, deleter);
+  }
+  pthread_rwlock_destroy(&lst->head.lock);
+  pthread_rwlock_destroy(&lst->tail.lock);
+  free(lst);
+}
+int clist_push_back(clist_t* lst, void* data) {
+  if (!lst || !data) return -1;
+
+  clist_node_t* node = clist_node_create(data);
+  if (!node) return -1;
+  for (;;) {
+    // The last element cannot be unlinked while the tail is held. Pin it, then lock it and the tail in order
+    pthread_rwlock_rdlock(&lst->tail.lock);
+    clist_node_t* last = lst->tail.prev;
+    clist_node_hold(last);
+    pthread_rwlock_unlock(&lst->tail.lock);
+    pthread_rwlock_wrlock(&last->lock);
+    pthread_rwlock_wrlock(&lst->tail.lock);
+    int linked = lst->tail.prev == last;
+    if (linked) clist_link_before(lst, &lst->tail, node);
+    pthread_rwlock_unlock(&lst->tail.lock);
+    pthread_rwlock_unlock(&last->lock);
+    clist_node_release(last);
+    if (linked) return 0;
+  }
+}
+int clist_push_front(clist_t* lst, void* data) {
+  if (!lst || !data) return -1;
+
+  clist_node_t* node = clist_node_create(data);
+  if (!node) return -1;
+  pthread_rwlock_wrlock(&lst->head.lock);
+  clist_node_t* first = lst->head.next;
+  pthread_rwlock_wrlock(&first->lock);
+  clist_link_before(lst, first, node);
+  pthread_rwlock_unlock(&first->lock);
+  pthread_rwlock_unlock(&lst->head.lock);
+  return 0;
+}
+void* clist_pop_front(clist_t* lst) {
+  if (!lst) return NULL;
+
+  pthread_rwlock_wrlock(&lst->head.lock);
+  clist_node_t* first = lst->head.next;
+  if (first == &lst->tail) {
+    pthread_rwlock_unlock(&lst->head.lock);
+    return NULL;
+  }
+  pthread_rwlock_wrlock(&first->lock);
+  clist_node_t* next = first->next;
+  pthread_rwlock_wrlock(&next->lock);
+  lst->head.next = next;
+  next->prev = &lst->head;
+  first->next = first->prev = NULL;
+  atomic_fetch_sub(&lst->size, 1);
+  pthread_rwlock_unlock(&next->lock);
+  pthread_rwlock_unlock(&first->lock);
+  pthread_rwlock_unlock(&lst->head.lock);
+
+  void* data = first->data;
+  clist_node_release(first);
+  return data;
+}
+int clist_insert_before(clist_t* lst, const void* value, int (*predicate)(const void* data1, const void* data2),
+                        void* data) {
+  if (!lst || !predicate || !data) return -1;
+
+  clist_node_t* node = clist_node_create(data);
+  if (!node) return -1;
+  clist_node_t* pred = NULL;
+  clist_node_t* cur = clist_lock_find(lst, value, predicate, &pred);
+  clist_link_before(lst, cur, node);
+  pthread_rwlock_unlock(&cur->lock);
+  pthread_rwlock_unlock(&pred->lock);
+  return 0;
+}
+int clist_erase(clist_t* lst, const void* value, int (*predicate)(const void* data1, const void* data2),
+                void (*deleter)(void* data)) {
+  if (!lst || !predicate) return 0;
+
+  clist_node_t* pred = NULL;
+  clist_node_t* cur = clist_lock_find(lst, value, predicate, &pred);
+  if (cur == &lst->tail) {
+    pthread_rwlock_unlock(&cur->lock);
+    pthread_rwlock_unlock(&pred->lock);
+    return 0;
+  }
+  clist_node_t* next = cur->next;
+  pthread_rwlock_wrlock(&next->lock);
+  pred->next = next;
+  next->prev = pred;
+  cur->next = cur->prev = NULL;
+  atomic_fetch_sub(&lst->size, 1);
+  pthread_rwlock_unlock(&next->lock);
+  pthread_rwlock_unlock(&cur->lock);
+  pthread_rwlock_unlock(&pred->lock);
+  clist_node_destroy(cur, deleter);
+  return 1;
+}
+int clist_find(clist_t* lst, const void* value, int (*predicate)(const void* data1, const void* data2),
+               void (*fn)(void* data, void* ctx), void* ctx) {
+  if (!lst || !predicate) return 0;
+
+  clist_node_t* prev = &lst->head;
+  pthread_rwlock_rdlock(&prev->lock);
+  clist_node_t* cur = prev->next;
+  while (cur != &lst->tail) {
+    pthread_rwlock_rdlock(&cur->lock);
+    pthread_rwlock_unlock(&prev->lock);
+    if (0 == predicate(cur->data, value)) {
+      if (fn) fn(cur->data, ctx);
+      pthread_rwlock_unlock(&cur->lock);
+      return 1;
+    }
+    prev = cur;
+    // Set next
+    cur = cur->next;
+  }
+  pthread_rwlock_unlock(&prev->lock);
+  return 0;
+}
+int clist_count(clist_t* lst, const void* value, int (*predicate)(const void* data1, const void* data2)) {
+  if (!lst || !predicate) return 0;
+
+  int count = 0;
+  clist_node_t* prev = &lst->head;
+  pthread_rwlock_rdlock(&prev->lock);
+  clist_node_t* cur = prev->next;
+  while (cur != &lst->tail) {
+    pthread_rwlock_rdlock(&cur->lock);
+    pthread_rwlock_unlock(&prev->lock);
+    if (0 == predicate(cur->data, value)) count++;
+    prev = cur;
+    // Set next
+    cur = cur->next;
+  }
+  pthread_rwlock_unlock(&prev->lock);
+  return count;
+}
+void clist_for_each(clist_t* lst, void (*fn)(void* data, void* ctx), void* ctx) {
+  if (!lst || !fn) return;
+
+  clist_node_t* prev = &lst->head;
+  pthread_rwlock_rdlock(&prev->lock);
+  clist_node_t* cur = prev->next;
+  while (cur != &lst->tail) {
+    pthread_rwlock_rdlock(&cur->lock);
+    pthread_rwlock_unlock(&prev->lock);
+    fn(cur->data, ctx);
+    prev = cur;
+    // Set next
+    cur = cur->next;
+  }
+  pthread_rwlock_unlock(&prev->lock);
+}
+size_t clist_size(const clist_t* lst) { return lst ? atomic_load(&((clist_t*)lst)->size) : 0; }
+int clist_empty(const clist_t* lst) { return clist_size(lst) == 0; }
@@ -0,0 +1,151 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "container/deque.h"
+
+#define DEQUE_MIN_CAPACITY 16
+
+////////////////////////////////////////////////////////////////////////////
+// Private functions
+////////////////////////////////////////////////////////////////////////////
+static void deque_delete_data(void* data, void (*deleter)(void* data));
+static size_t deque_pos(const deque_t* dq, size_t pos);
+static void deque_delete_data(void* data, void (*deleter)(void* data)) {
+  if (deleter)
+    deleter(data);
+  else
+    free(data);
+}
+// Slot of the element at position 'pos' from the beginning
+static size_t deque_pos(const deque_t* dq, size_t pos) { return (dq->head + pos) & (dq->capacity - 1); }
+////////////////////////////////////////////////////////////////////////////
+// Public functions
+////////////////////////////////////////////////////////////////////////////
+void deque_init(deque_t* dq) {
+  if (!dq) return;
+  dq->data = NULL;
+  dq->capacity = dq->head = dq->size = 0;
+}
+void deque_destroy(deque_t* dq, void (*deleter)(void* data)) {
+  if (!dq) return;
+  deque_clear(dq, deleter);
+  free(dq->data);
+  deque_init(dq);
+}
+int deque_reserve(deque_t* dq, size_t count) {
+  if (!dq) return -1;
+  if (count <= dq->capacity) return 0;
+
+  size_t capacity = dq->capacity ? dq->capacity : DEQUE_MIN_CAPACITY;
+  while (capacity < count) {
+    if (capacity > SIZE_MAX / 2 / sizeof(void*)) return -1;
+    capacity *= 2;
+  }
+  void** data = (void**)realloc(dq->data, capacity * sizeof(void*));
+  if (!data) return -1;
+  // A wrapped run moves from the start of the buffer to just after the old end, which the new capacity always covers
+  if (dq->head + dq->size > dq->capacity) {
+    size_t wrapped = dq->head + dq->size - dq->capacity;
+    memcpy(data + dq->capacity, data, wrapped * sizeof(void*));
+  }
+  dq->data = data;
+  dq->capacity = capacity;
+  return 0;
+}
+int deque_push_back(deque_t* dq, void* data) {
+  if (!dq || (dq->size == dq->capacity && deque_reserve(dq, dq->size + 1))) return -1;
+
+  dq->data[deque_pos(dq, dq->size)] = data;
+  dq->size++;
+  return 0;
+}
+int deque_push_front(deque_t* dq, void* data) {
+  if (!dq || (dq->size == dq->capacity && deque_reserve(dq, dq->size + 1))) return -1;
+
+  dq->head = (dq->head - 1) & (dq->capacity - 1);
+  dq->data[dq->head] = data;
+  dq->size++;
+  return 0;
+}
+int deque_push_n(deque_t* dq, void* const* data, size_t count) {
+  if (!dq || (count && !data)) return -1;
+  if (!count) return 0;
+  if (count > SIZE_MAX - dq->size || deque_reserve(dq, dq->size + count)) return -1;
+
+  // At most two copies, up to the end of the buffer and then from its start
+  size_t pos = deque_pos(dq, dq->size);
+  size_t first = dq->capacity - pos < count ? dq->capacity - pos : count;
+  memcpy(dq->data + pos, data, first * sizeof(void*));
+  memcpy(dq->data, data + first, (count - first) * sizeof(void*));
+  dq->size += count;
+  return 0;
+}
+void deque_pop_front(deque_t* dq, void (*deleter)(void* data)) {
+  if (!dq || !dq->size) return;
+
+  void* data = dq->data[dq->head];
+  dq->head = (dq->head + 1) & (dq->capacity - 1);
+  dq->size--;
+  deque_delete_data(data, deleter);
+}
+void deque_pop_back(deque_t* dq, void (*deleter)(void* data)) {
+  if (!dq || !dq->size) return;
+
+  dq->size--;
+  deque_delete_data(dq->data[deque_pos(dq, dq->size)], deleter);
+}
+size_t deque_pop_n(deque_t* dq, void** data, size_t count) {
+  if (!dq || !data) return 0;
+  if (count > dq->size) count = dq->size;
+  if (!count) return 0;
+
+  size_t first = dq->capacity - dq->head < count ? dq->capacity - dq->head : count;
+  memcpy(data, dq->data + dq->head, first * sizeof(void*));
+  memcpy(data + first, dq->data, (count - first) * sizeof(void*));
+  dq->head = (dq->head + count) & (dq->capacity - 1);
+  dq->size -= count;
+  return count;
+}
+void* deque_at(const deque_t* dq, size_t pos) {
+  if (!dq || pos >= dq->size) return NULL;
+  return dq->data[deque_pos(dq, pos)];
+}
+void* deque_front(const deque_t* dq) { return deque_at(dq, 0); }
+void* deque_back(const deque_t* dq) {
+  if (!dq || !dq->size) return NULL;
+  return dq->data[deque_pos(dq, dq->size - 1)];
+}
+size_t deque_size(const deque_t* dq) {
+  if (!dq) return 0;
+  return dq->size;
+}
+int deque_empty(const deque_t* dq) { return deque_size(dq) == 0; }
+void deque_clear(deque_t* dq, void (*deleter)(void* data)) {
+  if (!dq) return;
+
+  size_t i = 0;
+  for (i = 0; i < dq->size; i++) deque_delete_data(dq->data[deque_pos(dq, i)], deleter);
+  dq->head = dq->size = 0;
+}
@@ -0,0 +1,312 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "container/hashmap.h"
+
+// Old table slots migrated per insert or erase while growing
+#define HASHMAP_MIGRATE_STEP 16
+#define HASHMAP_MIN_CAPACITY 16
+
+// Slot of a table, an empty slot has no data. 'hash' is the mixed hash, kept so that probing and migration never call
+// the hash function again.
+typedef struct hashmap_slot_t {
+  size_t hash;
+  void* data;
+} hashmap_slot_t;
+
+typedef struct hashmap_table_t {
+  hashmap_slot_t* slots;
+  size_t capacity;  // Power of two, or 0
+  size_t count;
+} hashmap_table_t;
+
+// While growing, 'old' holds the previous table and the slots before 'migrate_pos' have been moved into 'cur'. Old
+// slots that were moved or erased hold the tombstone, so probe chains running through them stay intact.
+struct hashmap_t {
+  hashmap_table_t cur;
+  hashmap_table_t old;
+  size_t migrate_pos;
+  size_t (*hash)(const void* data);
+  int (*predicate)(const void* data1, const void* data2);
+};
+
+static char hashmap_tombstone;
+#define HASHMAP_TOMBSTONE ((void*)&hashmap_tombstone)
+
+////////////////////////////////////////////////////////////////////////////
+// Private functions
+////////////////////////////////////////////////////////////////////////////
+static size_t hashmap_mix(size_t hash);
+static void hashmap_delete_data(void* data, void (*deleter)(void* data));
+static size_t hashmap_dist(const hashmap_table_t* table, size_t pos);
+static void hashmap_place(hashmap_table_t* table, size_t hash, void* data);
+static hashmap_slot_t* hashmap_lookup(const hashmap_t* map, const void* value, size_t hash, hashmap_table_t** table);
+static void hashmap_unlink(hashmap_t* map, hashmap_table_t* table, hashmap_slot_t* slot);
+static void hashmap_migrate(hashmap_t* map, size_t count);
+static int hashmap_grow(hashmap_t* map, size_t capacity);
+static int hashmap_prepare(hashmap_t* map);
+// Spread the user hash over the low bits, which alone select the home slot
+static size_t hashmap_mix(size_t hash) {
+  uint64_t h = (uint64_t)hash * UINT64_C(0x9E3779B97F4A7C15);
+  return (size_t)(h ^ (h >> 32));
+}
+static void hashmap_delete_data(void* data, void (*deleter)(void* data)) {
+  if (deleter)
+    deleter(data);
+  else
+    free(data);
+}
+// Distance of the element at 'pos' from its home slot
+static size_t hashmap_dist(const hashmap_table_t* table, size_t pos) {
+  return (pos - table->slots[pos].hash) & (table->capacity - 1);
+}
+// Robin Hood insertion into the current table, room must have been reserved. An element travelling further than the
+// one in a slot takes that slot and the evicted element moves on.
+static void hashmap_place(hashmap_table_t* table, size_t hash, void* data) {
+  size_t mask = table->capacity - 1;
+  size_t pos = hash & mask, dist = 0;
+  while (table->slots[pos].data) {
+    size_t cur_dist = hashmap_dist(table, pos);
+    if (cur_dist < dist) {
+      hashmap_slot_t tmp = table->slots[pos];
+      table->slots[pos].hash = hash;
+      table->slots[pos].data = data;
+      hash = tmp.hash;
+      data = tmp.data;
+      dist = cur_dist;
+    }
+    pos = (pos + 1) & mask;
+    dist++;
+  }
+  table->slots[pos].hash = hash;
+  table->slots[pos].data = data;
+  table->count++;
+}
+// Find the slot of the element equal to 'value' in the current table, then in the old one. The table is returned
+// through 'table'.
+static hashmap_slot_t* hashmap_lookup(const hashmap_t* map, const void* value, size_t hash, hashmap_table_t** table) {
+  const hashmap_table_t* cur = &map->cur;
+  if (cur->count) {
+    size_t mask = cur->capacity - 1;
+    size_t pos = hash & mask, dist = 0;
+    // The Robin Hood invariant ends the search at the first element closer to its home than the probe
+    while (cur->slots[pos].data && hashmap_dist(cur, pos) >= dist) {
+      hashmap_slot_t* slot = &cur->slots[pos];
+      if (slot->hash == hash && 0 == map->predicate(slot->data, value)) {
+        *table = (hashmap_table_t*)cur;
+        return slot;
+      }
+      pos = (pos + 1) & mask;
+      dist++;
+    }
+  }
+  const hashmap_table_t* old = &map->old;
+  if (old->count) {
+    size_t mask = old->capacity - 1;
+    size_t pos = hash & mask;
+    // Tombstones break the invariant, the old table is searched up to an empty slot
+    while (old->slots[pos].data) {
+      hashmap_slot_t* slot = &old->slots[pos];
+      if (slot->data != HASHMAP_TOMBSTONE && slot->hash == hash && 0 == map->predicate(slot->data, value)) {
+        *table = (hashmap_table_t*)old;
+        return slot;
+      }
+      pos = (pos + 1) & mask;
+    }
+  }
+  return NULL;
+}
+// Empty a slot found by hashmap_lookup
+static void hashmap_unlink(hashmap_t* map, hashmap_table_t* table, hashmap_slot_t* slot) {
+  table->count--;
+  if (table == &map->old) {
+    slot->data = HASHMAP_TOMBSTONE;
+    return;
+  }
+  // Shift the following elements back until one is at its home slot, so no tombstone is needed
+  size_t mask = table->capacity - 1;
+  size_t pos = (size_t)(slot - table->slots);
+  size_t next = (pos + 1) & mask;
+  while (table->slots[next].data && hashmap_dist(table, next)) {
+    table->slots[pos] = table->slots[next];
+    pos = next;
+    next = (next + 1) & mask;
+  }
+  table->slots[pos].data = NULL;
+}
+// Move up to 'count' old slots into the current table, dropping the old table once all have been moved
+static void hashmap_migrate(hashmap_t* map, size_t count) {
+  hashmap_table_t* old = &map->old;
+  if (!old->slots) return;
+
+  while (count-- && map->migrate_pos < old->capacity) {
+    hashmap_slot_t* slot = &old->slots[map->migrate_pos++];
+    if (!slot->data || slot->data == HASHMAP_TOMBSTONE) continue;
+    hashmap_place(&map->cur, slot->hash, slot->data);
+    slot->data = HASHMAP_TOMBSTONE;
+    old->count--;
+  }
+  if (map->migrate_pos < old->capacity) return;
+  free(old->slots);
+  memset(old, 0, sizeof(*old));
+  map->migrate_pos = 0;
+}
+// Start growing into a table of 'capacity' slots, the previous growth must be complete
+static int hashmap_grow(hashmap_t* map, size_t capacity) {
+  hashmap_slot_t* slots = (hashmap_slot_t*)calloc(capacity, sizeof(hashmap_slot_t));
+  if (!slots) return -1;
+  if (map->cur.count) {
+    map->old = map->cur;
+    map->migrate_pos = 0;
+  } else {
+    free(map->cur.slots);
+  }
+  map->cur.slots = slots;
+  map->cur.capacity = capacity;
+  map->cur.count = 0;
+  return 0;
+}
+// Advance the migration and make room for one more element, keeping the load factor at or below 3/4. A table twice
+// as large is at most 3/8 full when growing starts, and migration completes long before it reaches 3/4.
+static int hashmap_prepare(hashmap_t* map) {
+  hashmap_migrate(map, HASHMAP_MIGRATE_STEP);
+  size_t count = map->cur.count + map->old.count + 1;
+  if (count * 4 <= map->cur.capacity * 3) return 0;
+  hashmap_migrate(map, SIZE_MAX);
+  return hashmap_grow(map, map->cur.capacity ? map->cur.capacity * 2 : HASHMAP_MIN_CAPACITY);
+}
+////////////////////////////////////////////////////////////////////////////
+// Public functions
+////////////////////////////////////////////////////////////////////////////
+hashmap_t* hashmap_create(size_t (*hash)(const void* data), int (*predicate)(const void* data1, const void* data2)) {
+  if (!hash || !predicate) return NULL;
+
+  hashmap_t* map = (hashmap_t*)calloc(1, sizeof(hashmap_t));
+  if (!map) return NULL;
+  map->hash = hash;
+  map->predicate = predicate;
+  return map;
+}
+void hashmap_destroy(hashmap_t* map, void (*deleter)(void* data)) {
+  if (!map) return;
+
+  hashmap_clear(map, deleter);
+  free(map->cur.slots);
+  free(map);
+}
+int hashmap_reserve(hashmap_t* map, size_t count) {
+  if (!map) return -1;
+
+  // Explicit reservation completes the move at once
+  hashmap_migrate(map, SIZE_MAX);
+  if (count > SIZE_MAX / 4) return -1;
+  if (count * 4 <= map->cur.capacity * 3) return 0;
+  size_t capacity = map->cur.capacity ? map->cur.capacity : HASHMAP_MIN_CAPACITY;
+  while (count * 4 > capacity * 3) capacity *= 2;
+  if (hashmap_grow(map, capacity)) return -1;
+  hashmap_migrate(map, SIZE_MAX);
+  return 0;
+}
+int hashmap_insert(hashmap_t* map, void* data) {
+  if (!map || !data) return -1;
+
+  size_t hash = hashmap_mix(map->hash(data));
+  hashmap_table_t* table = NULL;
+  if (hashmap_lookup(map, data, hash, &table)) return 1;
+  if (hashmap_prepare(map)) return -1;
+  hashmap_place(&map->cur, hash, data);
+  return 0;
+}
+int hashmap_put(hashmap_t* map, void* data, void (*deleter)(void* data)) {
+  if (!map || !data) return -1;
+
+  size_t hash = hashmap_mix(map->hash(data));
+  hashmap_table_t* table = NULL;
+  hashmap_slot_t* slot = hashmap_lookup(map, data, hash, &table);
+  if (slot) {
+    void* tmp = slot->data;
+    slot->data = data;
+    // Putting the stored element again must not free it
+    if (tmp != data) hashmap_delete_data(tmp, deleter);
+    return 0;
+  }
+  if (hashmap_prepare(map)) return -1;
+  hashmap_place(&map->cur, hash, data);
+  return 0;
+}
+void* hashmap_find(const hashmap_t* map, const void* value) {
+  if (!map) return NULL;
+
+  hashmap_table_t* table = NULL;
+  hashmap_slot_t* slot = hashmap_lookup(map, value, hashmap_mix(map->hash(value)), &table);
+  return slot ? slot->data : NULL;
+}
+void* hashmap_remove(hashmap_t* map, const void* value) {
+  if (!map) return NULL;
+
+  hashmap_table_t* table = NULL;
+  hashmap_slot_t* slot = hashmap_lookup(map, value, hashmap_mix(map->hash(value)), &table);
+  if (!slot) return NULL;
+  void* data = slot->data;
+  hashmap_unlink(map, table, slot);
+  hashmap_migrate(map, HASHMAP_MIGRATE_STEP);
+  return data;
+}
+int hashmap_erase(hashmap_t* map, const void* value, void (*deleter)(void* data)) {
+  void* data = hashmap_remove(map, value);
+  if (!data) return 0;
+  hashmap_delete_data(data, deleter);
+  return 1;
+}
+int hashmap_for_each(hashmap_t* map, int (*fn)(void* data, void* ctx), void* ctx) {
+  if (!map || !fn) return -1;
+
+  size_t i = 0;
+  for (i = 0; i < map->cur.capacity; i++)
+    if (map->cur.slots[i].data) fn(map->cur.slots[i].data, ctx);
+  for (i = map->migrate_pos; i < map->old.capacity; i++)
+    if (map->old.slots[i].data && map->old.slots[i].data != HASHMAP_TOMBSTONE) fn(map->old.slots[i].data, ctx);
+  return 0;
+}
+void hashmap_clear(hashmap_t* map, void (*deleter)(void* data)) {
+  if (!map) return;
+
+  size_t i = 0;
+  for (i = 0; i < map->cur.capacity; i++)
+    if (map->cur.slots[i].data) hashmap_delete_data(map->cur.slots[i].data, deleter);
+  for (i = map->migrate_pos; i < map->old.capacity; i++)
+    if (map->old.slots[i].data && map->old.slots[i].data != HASHMAP_TOMBSTONE)
+      hashmap_delete_data(map->old.slots[i].data, deleter);
+  if (map->cur.slots) memset(map->cur.slots, 0, map->cur.capacity * sizeof(hashmap_slot_t));
+  map->cur.count = 0;
+  free(map->old.slots);
+  memset(&map->old, 0, sizeof(map->old));
+  map->migrate_pos = 0;
+}
+size_t hashmap_size(const hashmap_t* map) {
+  if (!map) return 0;
+  return map->cur.count + map->old.count;
+}
+int hashmap_empty(const hashmap_t* map) { return hashmap_size(map) == 0; }
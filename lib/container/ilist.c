@@ -0,0 +1,173 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <string.h>  // for 'memset'
+
+#include "container/ilist.h"
+
+////////////////////////////////////////////////////////////////////////////
+// Public functions
+////////////////////////////////////////////////////////////////////////////
+void ilist_init(ilist_t* lst) {
+  if (!lst) return;
+  memset(lst, 0, sizeof(*lst));
+}
+void ilist_push_back(ilist_t* lst, ilist_link_t* link) {
+  if (!lst || !link) return;
+
+  link->next = NULL;
+  link->prev = lst->tail;
+  if (lst->tail)
+    (lst->tail)->next = link;
+  else
+    lst->head = link;
+  lst->tail = link;
+  lst->size++;
+}
+void ilist_push_front(ilist_t* lst, ilist_link_t* link) {
+  if (!lst || !link) return;
+
+  link->prev = NULL;
+  link->next = lst->head;
+  if (lst->head)
+    (lst->head)->prev = link;
+  else
+    lst->tail = link;
+  lst->head = link;
+  lst->size++;
+}
+ilist_link_t* ilist_pop_front(ilist_t* lst) {
+  if (!lst || !lst->head) return NULL;
+
+  ilist_link_t* link = lst->head;
+  ilist_erase(lst, link);
+  return link;
+}
+ilist_link_t* ilist_pop_back(ilist_t* lst) {
+  if (!lst || !lst->tail) return NULL;
+
+  ilist_link_t* link = lst->tail;
+  ilist_erase(lst, link);
+  return link;
+}
+void ilist_erase(ilist_t* lst, ilist_link_t* link) {
+  if (!lst || !link) return;
+
+  // Reassign address node
+  if (link->prev)
+    (link->prev)->next = link->next;
+  else
+    lst->head = link->next;
+  if (link->next)
+    (link->next)->prev = link->prev;
+  else
+    lst->tail = link->prev;
+  link->next = link->prev = NULL;
+  lst->size--;
+}
+ilist_link_t* ilist_front(const ilist_t* lst) {
+  if (!lst) return NULL;
+  return lst->head;
+}
+ilist_link_t* ilist_back(const ilist_t* lst) {
+  if (!lst) return NULL;
+  return lst->tail;
+}
+size_t ilist_size(const ilist_t* lst) {
+  if (!lst) return 0;
+  return lst->size;
+}
+int ilist_empty(const ilist_t* lst) {
+  if (!lst || !lst->head) return 1;
+  return 0;
+}
+void ilist_clear(ilist_t* lst, void (*deleter)(ilist_link_t* link)) {
+  if (!lst) return;
+
+  ilist_link_t* cur = lst->head;
+  lst->head = lst->tail = NULL;
+  lst->size = 0;
+  while (cur) {
+    ilist_link_t* tmp = cur;
+    // Set next
+    cur = cur->next;
+    tmp->next = tmp->prev = NULL;
+    if (deleter) deleter(tmp);
+  }
+}
+////////////////////////////////////////////////////////////////////////////
+// Algorithms
+////////////////////////////////////////////////////////////////////////////
+int ilist_for_each(ilist_t* lst, int (*fn)(ilist_link_t* link)) {
+  if (!lst) return 0;
+
+  ilist_link_t* cur = lst->head;
+  while (cur) {
+    ilist_link_t* tmp = cur;
+    // Set next
+    cur = cur->next;
+    if (fn) fn(tmp);
+  }
+  return 0;
+}
+int ilist_count(const ilist_t* lst, const void* value, int (*predicate)(const ilist_link_t* link, const void* value)) {
+  if (!predicate || !lst) return -1;
+
+  int count = 0;
+  const ilist_link_t* cur = lst->head;
+  while (cur) {
+    if (0 == predicate(cur, value)) count++;
+    // Set next
+    cur = cur->next;
+  }
+  return count;
+}
+ilist_link_t* ilist_find(const ilist_t* lst, const void* value,
+                         int (*predicate)(const ilist_link_t* link, const void* value)) {
+  if (!predicate || !lst) return NULL;
+
+  ilist_link_t* cur = lst->head;
+  while (cur) {
+    if (0 == predicate(cur, value)) return cur;
+    // Set next
+    cur = cur->next;
+  }
+  return NULL;
+}
+int ilist_remove_if(ilist_t* lst, const void* value, int (*predicate)(const ilist_link_t* link, const void* value),
+                    void (*deleter)(ilist_link_t* link)) {
+  if (!predicate || !lst) return -1;
+
+  int count = 0;
+  ilist_link_t* cur = lst->head;
+  while (cur) {
+    ilist_link_t* tmp = cur;
+    // Set next
+    cur = cur->next;
+
+    if (0 == predicate(tmp, value)) {
+      ilist_erase(lst, tmp);
+      if (deleter) deleter(tmp);
+      count++;
+    }
+  }
+  return count;
+}
@@ -0,0 +1,261 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include "container/lfqueue.h"
+
+// Hazard pointers per handle: the node being read and its successor
+#define LFQUEUE_HAZARDS 2
+// Head and tail are kept on separate cache lines, so producers and consumers do not share one
+#define LFQUEUE_CACHE_LINE 64
+
+typedef struct lfqueue_node_t {
+  _Atomic(struct lfqueue_node_t*) next;
+  void* data;
+} lfqueue_node_t;
+
+struct lfqueue_handle_t {
+  _Atomic(lfqueue_node_t*) hazard[LFQUEUE_HAZARDS];
+  atomic_int active;
+  lfqueue_t* queue;
+  struct lfqueue_handle_t* next;  // Never changes once the handle is published
+  lfqueue_node_t** retired;       // Removed nodes not yet freed
+  size_t retired_count;
+  size_t retired_capacity;
+};
+
+struct lfqueue_t {
+  _Alignas(LFQUEUE_CACHE_LINE) _Atomic(lfqueue_node_t*) head;
+  _Alignas(LFQUEUE_CACHE_LINE) _Atomic(lfqueue_node_t*) tail;
+  _Alignas(LFQUEUE_CACHE_LINE) _Atomic(lfqueue_handle_t*) handles;
+  atomic_size_t handle_count;
+};
+////////////////////////////////////////////////////////////////////////////
+// Private functions
+////////////////////////////////////////////////////////////////////////////
+static int lfqueue_hazardous(const lfqueue_t* queue, const lfqueue_node_t* node);
+static void lfqueue_retire(lfqueue_handle_t* handle, lfqueue_node_t* node);
+static void lfqueue_scan(lfqueue_handle_t* handle);
+// Test whether a hazard pointer of any handle refers to the node
+static int lfqueue_hazardous(const lfqueue_t* queue, const lfqueue_node_t* node) {
+  lfqueue_handle_t* cur = atomic_load(&((lfqueue_t*)queue)->handles);
+  while (cur) {
+    size_t j = 0;
+    for (j = 0; j < LFQUEUE_HAZARDS; j++)
+      if (atomic_load(&cur->hazard[j]) == node) return 1;
+    // Set next
+    cur = cur->next;
+  }
+  return 0;
+}
+// Set a node aside until no hazard pointer refers to it anymore
+static void lfqueue_retire(lfqueue_handle_t* handle, lfqueue_node_t* node) {
+  if (handle->retired_count == handle->retired_capacity) {
+    size_t capacity = handle->retired_capacity ? handle->retired_capacity * 2 : 64;
+    lfqueue_node_t** retired = (lfqueue_node_t**)realloc(handle->retired, capacity * sizeof(lfqueue_node_t*));
+    if (!retired) {
+      // Keep going with the nodes at hand. Without room to set this one aside, wait until it is safe to free: hazard
+      // pointers are only held for the duration of a push or a pop
+      lfqueue_scan(handle);
+      if (handle->retired_count == handle->retired_capacity) {
+        while (lfqueue_hazardous(handle->queue, node)) sched_yield();
+        free(node);
+        return;
+      }
+    } else {
+      handle->retired = retired;
+      handle->retired_capacity = capacity;
+    }
+  }
+  handle->retired[handle->retired_count++] = node;
+  // Amortize the scan over a number of retirements proportional to the number of hazard pointers
+  if (handle->retired_count >= 2 * LFQUEUE_HAZARDS * atomic_load(&handle->queue->handle_count) + 16)
+    lfqueue_scan(handle);
+}
+// Free the retired nodes no hazard pointer refers to
+static void lfqueue_scan(lfqueue_handle_t* handle) {
+  size_t i = 0, kept = 0;
+  for (i = 0; i < handle->retired_count; i++) {
+    lfqueue_node_t* node = handle->retired[i];
+    if (lfqueue_hazardous(handle->queue, node))
+      handle->retired[kept++] = node;
+    else
+      free(node);
+  }
+  handle->retired_count = kept;
+}
+////////////////////////////////////////////////////////////////////////////
+// Public functions
+////////////////////////////////////////////////////////////////////////////
+lfqueue_t* lfqueue_create(void) {
+  lfqueue_t* queue = (lfqueue_t*)aligned_alloc(LFQUEUE_CACHE_LINE, sizeof(lfqueue_t));
+  if (!queue) return NULL;
+  // The queue always holds a dummy node, the first element is the one after it
+  lfqueue_node_t* dummy = (lfqueue_node_t*)calloc(1, sizeof(lfqueue_node_t));
+  if (!dummy) {
+    free(queue);
+    return NULL;
+  }
+  atomic_init(&dummy->next, NULL);
+  atomic_init(&queue->head, dummy);
+  atomic_init(&queue->tail, dummy);
+  atomic_init(&queue->handles, NULL);
+  atomic_init(&queue->handle_count, 0);
+  return queue;
+}
+void lfqueue_destroy(lfqueue_t* queue, void (*deleter)(void* data)) {
+  if (!queue) return;
+
+  lfqueue_node_t* node = atomic_load(&queue->head);
+  // Skip the dummy node
+  lfqueue_node_t* cur = atomic_load(&node->next);
+  free(node);
+  while (cur) {
+    lfqueue_node_t* tmp = cur;
+    // Set next
+    cur = atomic_load(&cur->next);
+    if (deleter)
+      deleter(tmp->data);
+    else
+      free(tmp->data);
+    free(tmp);
+  }
+  lfqueue_handle_t* handle = atomic_load(&queue->handles);
+  while (handle) {
+    lfqueue_handle_t* tmp = handle;
+    // Set next
+    handle = handle->next;
+    size_t i = 0;
+    for (i = 0; i < tmp->retired_count; i++) free(tmp->retired[i]);
+    free(tmp->retired);
+    free(tmp);
+  }
+  free(queue);
+}
+lfqueue_handle_t* lfqueue_acquire(lfqueue_t* queue) {
+  if (!queue) return NULL;
+
+  // Reuse a released handle
+  lfqueue_handle_t* handle = atomic_load(&queue->handles);
+  while (handle) {
+    int inactive = 0;
+    if (atomic_compare_exchange_strong(&handle->active, &inactive, 1)) return handle;
+    // Set next
+    handle = handle->next;
+  }
+  handle = (lfqueue_handle_t*)calloc(1, sizeof(lfqueue_handle_t));
+  if (!handle) return NULL;
+  size_t i = 0;
+  for (i = 0; i < LFQUEUE_HAZARDS; i++) atomic_init(&handle->hazard[i], NULL);
+  atomic_init(&handle->active, 1);
+  handle->queue = queue;
+  // Publish
+  lfqueue_handle_t* first = atomic_load(&queue->handles);
+  do {
+    handle->next = first;
+  } while (!atomic_compare_exchange_weak(&queue->handles, &first, handle));
+  atomic_fetch_add(&queue->handle_count, 1);
+  return handle;
+}
+void lfqueue_release(lfqueue_handle_t* handle) {
+  if (!handle) return;
+
+  size_t i = 0;
+  for (i = 0; i < LFQUEUE_HAZARDS; i++) atomic_store(&handle->hazard[i], NULL);
+  // Nodes still referenced by other threads stay with the handle until its next owner scans again
+  lfqueue_scan(handle);
+  atomic_store(&handle->active, 0);
+}
+int lfqueue_push(lfqueue_handle_t* handle, void* data) {
+  if (!handle || !data) return -1;
+
+  lfqueue_t* queue = handle->queue;
+  lfqueue_node_t* node = (lfqueue_node_t*)malloc(sizeof(lfqueue_node_t));
+  if (!node) return -1;
+  node->data = data;
+  atomic_init(&node->next, NULL);
+
+  for (;;) {
+    lfqueue_node_t* tail = atomic_load(&queue->tail);
+    atomic_store(&handle->hazard[0], tail);
+    // The tail may have been removed and freed before the hazard pointer was visible
+    if (tail != atomic_load(&queue->tail)) continue;
+
+    lfqueue_node_t* next = atomic_load(&tail->next);
+    if (tail != atomic_load(&queue->tail)) continue;
+    if (next) {
+      // Help a lagging producer move the tail
+      atomic_compare_exchange_strong(&queue->tail, &tail, next);
+      continue;
+    }
+    lfqueue_node_t* expected = NULL;
+    if (atomic_compare_exchange_strong(&tail->next, &expected, node)) {
+      atomic_compare_exchange_strong(&queue->tail, &tail, node);
+      break;
+    }
+  }
+  atomic_store(&handle->hazard[0], NULL);
+  return 0;
+}
+void* lfqueue_pop(lfqueue_handle_t* handle) {
+  if (!handle) return NULL;
+
+  lfqueue_t* queue = handle->queue;
+  lfqueue_node_t* head = NULL;
+  void* data = NULL;
+  for (;;) {
+    head = atomic_load(&queue->head);
+    atomic_store(&handle->hazard[0], head);
+    if (head != atomic_load(&queue->head)) continue;
+
+    lfqueue_node_t* tail = atomic_load(&queue->tail);
+    lfqueue_node_t* next = atomic_load(&head->next);
+    atomic_store(&handle->hazard[1], next);
+    if (head != atomic_load(&queue->head)) continue;
+    if (!next) {
+      // Empty
+      atomic_store(&handle->hazard[0], NULL);
+      atomic_store(&handle->hazard[1], NULL);
+      return NULL;
+    }
+    if (head == tail) {
+      // Help a lagging producer move the tail
+      atomic_compare_exchange_strong(&queue->tail, &tail, next);
+      continue;
+    }
+    data = next->data;
+    // 'next' becomes the dummy node
+    if (atomic_compare_exchange_strong(&queue->head, &head, next)) break;
+  }
+  atomic_store(&handle->hazard[0], NULL);
+  atomic_store(&handle->hazard[1], NULL);
+  lfqueue_retire(handle, head);
+  return data;
+}
+int lfqueue_empty(const lfqueue_t* queue) {
+  if (!queue) return 1;
+  // Comparing pointers only: the head node may be freed by a concurrent pop at any time
+  lfqueue_t* q = (lfqueue_t*)queue;
+  return atomic_load(&q->head) == atomic_load(&q->tail);
+}
@@ -19,17 +19,83 @@
 ** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 ** SOFTWARE.
 *******************************************************************************/
+#include <limits.h>  // for 'INT_MAX'
 #include <stdarg.h>  // for 'vargs'
 #include <stdlib.h>
 #include <string.h>  // for 'memset'
+#include <sys/uio.h>  // for 'struct iovec'
 
 #include "container/list.h"
+#include "container/list_stats.h"
 
 typedef int func_ptr8_t(void*, void*, void*, void*, void*, void*, void*);
+
+// Instrumentation, compiled in with LIST_STATS only. The counters are thread-local, so counting needs no atomics
+#ifdef LIST_STATS
+static _Thread_local list_stats_t list_stats;
+#define LIST_STATS_ADD(field, n) (list_stats.field += (n))
+#else
+#define LIST_STATS_ADD(field, n) ((void)0)
+#endif
+// Count a call and evaluate to its result
+#define LIST_STATS_CALL(field, call) (LIST_STATS_ADD(field, 1), (call))
+
+// Hash index slot, an empty slot has no node
+typedef struct list_index_slot_t {
+  size_t hash;
+  dlist_t* node;
+} list_index_slot_t;
+
+// Hash index over the elements of a list header. Open addressing with linear probing; deletion shifts the following
+// slots back instead of leaving tombstones, so equal elements stay in probe order in the order they were indexed.
+typedef struct list_index_t {
+  list_index_slot_t* slots;
+  size_t capacity;  // Power of two
+  size_t count;
+  size_t (*hash)(const void* data);
+  int (*predicate)(const void* data1, const void* data2);
+} list_index_t;
+
+// Multiset slot used to compare lists, an empty slot has no data
+typedef struct list_multiset_slot_t {
+  size_t hash;
+  const void* data;
+  size_t count;
+} list_multiset_slot_t;
 ////////////////////////////////////////////////////////////////////////////
 // Private functions
 ////////////////////////////////////////////////////////////////////////////
 int call(int (*fn)(void* data), int count, void* data, char* buf[]);
+static dlist_t* list_node_alloc(const list_allocator_t* allocator);
+static void list_node_free(const list_allocator_t* allocator, dlist_t* node);
+static dlist_t* list_link_after(const list_allocator_t* allocator, dlist_t* cur, void* data);
+static void list_delete_data(void* data, void (*deleter)(void* data));
+static dlist_t* list_build_chain(const list_allocator_t* allocator, void* const* data, size_t count, dlist_t** last);
+static void lst_link_chain(list_t* lst, dlist_t* pos, dlist_t* first, dlist_t* last, size_t count);
+static void lst_unlink(list_t* lst, dlist_t* node);
+static int list_index_reserve(list_index_t* index, size_t count);
+static void list_index_add(list_index_t* index, dlist_t* node);
+static void list_index_del(list_index_t* index, const dlist_t* node);
+static void list_index_reset(list_index_t* index);
+static int list_erase_chain(dlist_t** head, dlist_t** tail, const list_allocator_t* allocator, list_index_t* index,
+                            const void* value, int (*predicate)(const void* data1, const void* data2),
+                            void (*deleter)(void* data), void (*deleter_n)(void** data, size_t count));
+static dlist_t* list_merge_chains(dlist_t* first1, dlist_t* first2,
+                                  int (*compare)(const void* data1, const void* data2));
+static dlist_t* list_sort_chain(dlist_t* first, int (*compare)(const void* data1, const void* data2));
+static dlist_t* list_relink_prev(dlist_t* first);
+static int list_unique_chain(dlist_t* first, dlist_t** tail, const list_allocator_t* allocator, list_index_t* index,
+                             int (*predicate)(const void* data1, const void* data2), void (*deleter)(void* data));
+static void list_sort_ptrs(void** data, void** tmp, size_t count, int (*compare)(const void* data1, const void* data2));
+static size_t list_fill_ptrs(const dlist_t* first, void** data);
+static int list_count_from(const dlist_t* first, const void* value,
+                           int (*predicate)(const void* data1, const void* data2), int limit);
+static size_t list_record_size(size_t size);
+static void list_put_le64(uint8_t* dst, uint64_t value);
+static uint64_t list_get_le64(const uint8_t* src);
+static int list_decoder_emit(list_decoder_t* decoder, const void* bytes, size_t size);
+static const list_index_slot_t* list_index_lookup(const list_index_t* index, const list_index_slot_t* slot,
+                                                  const void* value, size_t hash);
 // Call function pointer with parameters
 int call(int (*fn)(void* data), int count, void* data, char* buf[]) {
   if (!fn || !data || !buf) return -1;
@@ -61,14 +127,361 @@ int call(int (*fn)(void* data), int count, void* data, char* buf[]) {
   }
   return -1;
 }
+// Allocate a node, from the heap when no allocator is given
+static dlist_t* list_node_alloc(const list_allocator_t* allocator) {
+  LIST_STATS_ADD(node_allocs, 1);
+  if (!allocator) return (dlist_t*)calloc(1, sizeof(dlist_t));
+
+  dlist_t* node = (dlist_t*)allocator->alloc(allocator->ctx, sizeof(dlist_t));
+  if (node) memset(node, 0, sizeof(dlist_t));
+  return node;
+}
+static void list_node_free(const list_allocator_t* allocator, dlist_t* node) {
+  LIST_STATS_ADD(node_frees, 1);
+  if (!allocator)
+    free(node);
+  else
+    allocator->free(allocator->ctx, node);
+}
+// Allocate a node for 'data' and link it right after 'cur' (which may be null for a single-node chain)
+static dlist_t* list_link_after(const list_allocator_t* allocator, dlist_t* cur, void* data) {
+  dlist_t* node = list_node_alloc(allocator);
+  if (!node) return NULL;
+  node->data = data;
+  node->prev = cur;
+  if (cur) {
+    node->next = cur->next;
+    if (cur->next) (cur->next)->prev = node;
+    cur->next = node;
+  }
+  return node;
+}
+// Destroy element payload, by default the memory is just freed
+static void list_delete_data(void* data, void (*deleter)(void* data)) {
+  if (deleter)
+    LIST_STATS_CALL(deleter_calls, deleter(data));
+  else
+    free(data);
+}
+// Build a detached chain of 'count' nodes holding 'data', the last node is returned through 'last'
+static dlist_t* list_build_chain(const list_allocator_t* allocator, void* const* data, size_t count, dlist_t** last) {
+  dlist_t* first = NULL;
+  dlist_t* cur = NULL;
+  size_t i = 0;
+  for (i = 0; i < count; i++) {
+    dlist_t* node = list_link_after(allocator, cur, data[i]);
+    if (!node) {
+      // Roll back
+      while (cur) {
+        dlist_t* tmp = cur;
+        cur = cur->prev;
+        list_node_free(allocator, tmp);
+      }
+      return NULL;
+    }
+    if (!first) first = node;
+    cur = node;
+  }
+  *last = cur;
+  return first;
+}
+// Link the detached chain [first,last] of 'count' nodes right before 'pos', or at the end when 'pos' is null
+static void lst_link_chain(list_t* lst, dlist_t* pos, dlist_t* first, dlist_t* last, size_t count) {
+  dlist_t* prev = pos ? pos->prev : lst->tail;
+  first->prev = prev;
+  last->next = pos;
+  if (prev)
+    prev->next = first;
+  else
+    lst->head = first;
+  if (pos)
+    pos->prev = last;
+  else
+    lst->tail = last;
+  lst->size += count;
+}
+// Unlink 'node' from the list header, the node is kept
+static void lst_unlink(list_t* lst, dlist_t* node) {
+  if (node->prev)
+    (node->prev)->next = node->next;
+  else
+    lst->head = node->next;
+  if (node->next)
+    (node->next)->prev = node->prev;
+  else
+    lst->tail = node->prev;
+  node->next = node->prev = NULL;
+  lst->size--;
+}
+// Make room for 'count' more elements, keeping the load factor at or below 1/2
+static int list_index_reserve(list_index_t* index, size_t count) {
+  if ((index->count + count) * 2 <= index->capacity) return 0;
+
+  size_t capacity = index->capacity ? index->capacity : 16;
+  while ((index->count + count) * 2 > capacity) capacity *= 2;
+  list_index_slot_t* slots = (list_index_slot_t*)calloc(capacity, sizeof(list_index_slot_t));
+  if (!slots) return -1;
+  // Rehash, keeping the probe order of equal elements
+  size_t i = 0;
+  for (i = 0; i < index->capacity; i++) {
+    const list_index_slot_t* slot = &index->slots[i];
+    if (!slot->node) continue;
+    size_t pos = slot->hash & (capacity - 1);
+    while (slots[pos].node) pos = (pos + 1) & (capacity - 1);
+    slots[pos] = *slot;
+  }
+  free(index->slots);
+  index->slots = slots;
+  index->capacity = capacity;
+  return 0;
+}
+// Index a node, room must have been reserved
+static void list_index_add(list_index_t* index, dlist_t* node) {
+  size_t hash = index->hash(node->data);
+  size_t pos = hash & (index->capacity - 1);
+  while (index->slots[pos].node) pos = (pos + 1) & (index->capacity - 1);
+  index->slots[pos].hash = hash;
+  index->slots[pos].node = node;
+  index->count++;
+}
+static void list_index_del(list_index_t* index, const dlist_t* node) {
+  size_t mask = index->capacity - 1;
+  size_t pos = index->hash(node->data) & mask;
+  while (index->slots[pos].node && index->slots[pos].node != node) pos = (pos + 1) & mask;
+  if (!index->slots[pos].node) return;
+  // Shift the following slots of the cluster back over the hole
+  size_t next = (pos + 1) & mask;
+  while (index->slots[next].node) {
+    size_t home = index->slots[next].hash & mask;
+    // The slot may move only if its home is not within (pos, next]
+    if (((next - home) & mask) >= ((next - pos) & mask)) {
+      index->slots[pos] = index->slots[next];
+      pos = next;
+    }
+    next = (next + 1) & mask;
+  }
+  index->slots[pos].node = NULL;
+  index->count--;
+}
+static void list_index_reset(list_index_t* index) {
+  if (index->slots) memset(index->slots, 0, index->capacity * sizeof(list_index_slot_t));
+  index->count = 0;
+}
+// Find the next slot matching 'value', starting from 'slot' (or from the home slot when null)
+static const list_index_slot_t* list_index_lookup(const list_index_t* index, const list_index_slot_t* slot,
+                                                  const void* value, size_t hash) {
+  if (!index->count) return NULL;
+
+  size_t mask = index->capacity - 1;
+  size_t pos = slot ? (((size_t)(slot - index->slots) + 1) & mask) : (hash & mask);
+  while (index->slots[pos].node) {
+    slot = &index->slots[pos];
+    if (slot->hash == hash && 0 == LIST_STATS_CALL(predicate_calls, index->predicate(slot->node->data, value)))
+      return slot;
+    pos = (pos + 1) & mask;
+  }
+  return NULL;
+}
+// Unlink and destroy in one pass every node of the chain starting at 'head' for which predicate returns 0. Payloads go
+// to 'deleter' one by one, or to 'deleter_n' in batches of up to LIST_ERASE_BATCH. 'tail' is optional.
+static int list_erase_chain(dlist_t** head, dlist_t** tail, const list_allocator_t* allocator, list_index_t* index,
+                            const void* value, int (*predicate)(const void* data1, const void* data2),
+                            void (*deleter)(void* data), void (*deleter_n)(void** data, size_t count)) {
+  void* batch[LIST_ERASE_BATCH];
+  size_t batch_sz = 0;
+  int count = 0;
+
+  dlist_t* cur = *head;
+  while (cur) {
+    dlist_t* tmp = cur;
+    // Set next
+    cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
+    if (0 != LIST_STATS_CALL(predicate_calls, predicate(tmp->data, value))) continue;
+
+    // Reassign address node
+    if (tmp->prev)
+      (tmp->prev)->next = tmp->next;
+    else
+      *head = tmp->next;
+    if (tmp->next)
+      (tmp->next)->prev = tmp->prev;
+    else if (tail)
+      *tail = tmp->prev;
+    if (index) list_index_del(index, tmp);
+    // Delete element
+    if (deleter_n) {
+      batch[batch_sz++] = tmp->data;
+      if (batch_sz == LIST_ERASE_BATCH) {
+        LIST_STATS_ADD(deleter_calls, 1);
+        deleter_n(batch, batch_sz);
+        batch_sz = 0;
+      }
+    } else {
+      list_delete_data(tmp->data, deleter);
+    }
+    list_node_free(allocator, tmp);
+    count++;
+  }
+  if (batch_sz) LIST_STATS_CALL(deleter_calls, deleter_n(batch, batch_sz));
+  return count;
+}
+// Merge two sorted chains linked through 'next' only. On ties the element of 'first1' goes first, which keeps the
+// merge stable.
+static dlist_t* list_merge_chains(dlist_t* first1, dlist_t* first2,
+                                  int (*compare)(const void* data1, const void* data2)) {
+  dlist_t head;
+  dlist_t* tail = &head;
+  while (first1 && first2) {
+    if (compare(first2->data, first1->data) < 0) {
+      tail->next = first2;
+      first2 = first2->next;
+    } else {
+      tail->next = first1;
+      first1 = first1->next;
+    }
+    tail = tail->next;
+  }
+  tail->next = first1 ? first1 : first2;
+  return head.next;
+}
+// Bottom-up merge sort of a chain linked through 'next' only. runs[i] holds a sorted run of 2^i nodes, merged like a
+// binary counter, so no allocation is needed.
+static dlist_t* list_sort_chain(dlist_t* first, int (*compare)(const void* data1, const void* data2)) {
+  dlist_t* runs[64] = {NULL};
+  size_t i = 0;
+  while (first) {
+    dlist_t* carry = first;
+    // Set next
+    first = first->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
+    carry->next = NULL;
+    // Earlier runs go first, which keeps the sort stable
+    for (i = 0; runs[i]; i++) {
+      carry = list_merge_chains(runs[i], carry, compare);
+      runs[i] = NULL;
+    }
+    runs[i] = carry;
+  }
+  dlist_t* result = NULL;
+  for (i = 0; i < sizeof(runs) / sizeof(runs[0]); i++)
+    if (runs[i]) result = list_merge_chains(runs[i], result, compare);
+  return result;
+}
+// Restore the 'prev' links of a chain linked through 'next', returns its last node
+static dlist_t* list_relink_prev(dlist_t* first) {
+  dlist_t* prev = NULL;
+  while (first) {
+    first->prev = prev;
+    prev = first;
+    first = first->next;
+  }
+  return prev;
+}
+// Unlink and destroy the nodes equal to the node right before them. 'tail' is optional.
+static int list_unique_chain(dlist_t* first, dlist_t** tail, const list_allocator_t* allocator, list_index_t* index,
+                             int (*predicate)(const void* data1, const void* data2), void (*deleter)(void* data)) {
+  int count = 0;
+  dlist_t* cur = first;
+  while (cur && cur->next) {
+    dlist_t* tmp = cur->next;
+    if (0 != LIST_STATS_CALL(predicate_calls, predicate(tmp->data, cur->data))) {
+      // Set next
+      cur = tmp;
+      continue;
+    }
+    // Reassign address node
+    cur->next = tmp->next;
+    if (tmp->next)
+      (tmp->next)->prev = cur;
+    else if (tail)
+      *tail = cur;
+    if (index) list_index_del(index, tmp);
+    // Delete element
+    list_delete_data(tmp->data, deleter);
+    list_node_free(allocator, tmp);
+    count++;
+  }
+  return count;
+}
+// Merge sort an array of element pointers, 'tmp' is scratch space of the same size
+static void list_sort_ptrs(void** data, void** tmp, size_t count,
+                           int (*compare)(const void* data1, const void* data2)) {
+  if (count < 2) return;
+
+  size_t half = count / 2;
+  list_sort_ptrs(data, tmp, half, compare);
+  list_sort_ptrs(data + half, tmp, count - half, compare);
+  size_t i = 0, j = half, k = 0;
+  while (i < half && j < count) tmp[k++] = compare(data[j], data[i]) < 0 ? data[j++] : data[i++];
+  while (i < half) tmp[k++] = data[i++];
+  // The rest of the upper half is already in place
+  memcpy(data, tmp, k * sizeof(void*));
+}
+// Copy the element pointers of the chain starting at 'first', returns their number
+static size_t list_fill_ptrs(const dlist_t* first, void** data) {
+  size_t count = 0;
+  while (first) {
+    data[count++] = first->data;
+    first = first->next;
+  }
+  return count;
+}
+// Count the elements equal to 'value' from 'first' to the end, without rewinding to the front. Stops once 'limit'
+// elements are found
+static int list_count_from(const dlist_t* first, const void* value,
+                           int (*predicate)(const void* data1, const void* data2), int limit) {
+  int count = 0;
+  while (first && count < limit) {
+    if (0 == LIST_STATS_CALL(predicate_calls, predicate(first->data, value))) count++;
+    // Set next
+    first = first->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
+  }
+  return count;
+}
+// Bytes taken by the record of an element of 'size' bytes: prefix and padded payload
+static size_t list_record_size(size_t size) {
+  return sizeof(uint64_t) + ((size + LIST_RECORD_ALIGN - 1) & ~(size_t)(LIST_RECORD_ALIGN - 1));
+}
+static void list_put_le64(uint8_t* dst, uint64_t value) {
+  size_t i = 0;
+  for (i = 0; i < sizeof(uint64_t); i++) dst[i] = (uint8_t)(value >> (8 * i));
+}
+static uint64_t list_get_le64(const uint8_t* src) {
+  uint64_t value = 0;
+  size_t i = 0;
+  for (i = 0; i < sizeof(uint64_t); i++) value |= (uint64_t)src[i] << (8 * i);
+  return value;
+}
+// Append the element built from a completed record
+static int list_decoder_emit(list_decoder_t* decoder, const void* bytes, size_t size) {
+  void* val = NULL;
+  if (decoder->make) {
+    val = decoder->make(bytes, size);
+  } else {
+    val = malloc(size ? size : 1);
+    if (val && size) memcpy(val, bytes, size);
+  }
+  if (!val) return -1;
+  dlist_t* node = list_link_after(NULL, decoder->last, val);
+  if (!node) {
+    // Free memory
+    free(val);
+    return -1;
+  }
+  if (!decoder->last) *decoder->lst = node;
+  decoder->last = node;
+  return 0;
+}
 ////////////////////////////////////////////////////////////////////////////
 // Public functions
 ////////////////////////////////////////////////////////////////////////////
 dlist_t* list_push_back(dlist_t** lst, void* data) {
   if (!lst || !data) return NULL;
 
-  dlist_t* cur = list_front(*lst);
   if (*lst == NULL) {
+    LIST_STATS_ADD(node_allocs, 1);
     dlist_t* node = (dlist_t*)calloc(1, sizeof(dlist_t));
     if (!node) {
       return NULL;
@@ -79,18 +492,15 @@ dlist_t* list_push_back(dlist_t** lst, void* data) {
     node->prev = NULL;
     *lst = node;
     return *lst;
-  } else {
-    while (cur && (cur->next != NULL)) cur = cur->next;
+  }
+  // Any node of the chain leads to the last one, no need to rewind to the first
+  dlist_t* cur = *lst;
+  while (cur->next != NULL) {
+    cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
   }
 
-  dlist_t* node = (dlist_t*)calloc(1, sizeof(dlist_t));
-  if (!node) return NULL;
-  node->data = data;
-  node->next = NULL;
-  node->prev = cur;
-  if (cur) cur->next = node;
-
-  return node;
+  return list_link_after(NULL, cur, data);
 }
 int list_push_back_unique(dlist_t** lst, const void* value, void* src,
                           int (*predicate)(const void* data1, const void* data2),
@@ -128,10 +538,11 @@ void list_remove_if(dlist_t** lst, const void* value, int (*predicate)(const voi
 
   dlist_t* lst_ = list_front(*lst);
   while (lst_) {
-    if (0 == predicate(lst_->data, value)) {
+    if (0 == LIST_STATS_CALL(predicate_calls, predicate(lst_->data, value))) {
       if (!lst_->prev && !lst_->next) {
         // Delete element
         if (deleter) {
+          LIST_STATS_ADD(deleter_calls, 1);
           deleter(lst_->data);
           lst_->data = NULL;
         } else {
@@ -139,6 +550,7 @@ void list_remove_if(dlist_t** lst, const void* value, int (*predicate)(const voi
           free(lst_->data);
           lst_->data = NULL;
         }
+        LIST_STATS_ADD(node_frees, 1);
         free(lst_);
         *lst = lst_ = NULL;
 
@@ -159,6 +571,7 @@ void list_remove_if(dlist_t** lst, const void* value, int (*predicate)(const voi
       }
       // Delete element
       if (deleter) {
+        LIST_STATS_ADD(deleter_calls, 1);
         deleter(lst_->data);
         lst_->data = NULL;
       } else {
@@ -166,6 +579,7 @@ void list_remove_if(dlist_t** lst, const void* value, int (*predicate)(const voi
         free(lst_->data);
         lst_->data = NULL;
       }
+      LIST_STATS_ADD(node_frees, 1);
       free(lst_);
       lst_ = NULL;
 
@@ -173,9 +587,48 @@ void list_remove_if(dlist_t** lst, const void* value, int (*predicate)(const voi
     }
     // Set next
     lst_ = lst_->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
   }
   return;
 }
+int list_erase_if(dlist_t** lst, const void* value, int (*predicate)(const void* data1, const void* data2),
+                  void (*deleter)(void* data)) {
+  if (!lst || !predicate) return -1;
+
+  *lst = list_front(*lst);
+  return list_erase_chain(lst, NULL, NULL, NULL, value, predicate, deleter, NULL);
+}
+int list_erase_if_batch(dlist_t** lst, const void* value, int (*predicate)(const void* data1, const void* data2),
+                        void (*deleter_n)(void** data, size_t count)) {
+  if (!lst || !predicate || !deleter_n) return -1;
+
+  *lst = list_front(*lst);
+  return list_erase_chain(lst, NULL, NULL, NULL, value, predicate, NULL, deleter_n);
+}
+int list_sort(dlist_t** lst, int (*compare)(const void* data1, const void* data2)) {
+  if (!lst || !compare) return -1;
+
+  *lst = list_sort_chain(list_front(*lst), compare);
+  list_relink_prev(*lst);
+  return 0;
+}
+int list_merge(dlist_t** dst, dlist_t** src, int (*compare)(const void* data1, const void* data2)) {
+  if (!dst || !src || !compare) return -1;
+  if (!(*src)) return 0;
+  // Merging a chain with itself would never reach the end of either run
+  if (*dst && list_front(*dst) == list_front(*src)) return -1;
+
+  *dst = list_merge_chains(list_front(*dst), list_front(*src), compare);
+  list_relink_prev(*dst);
+  *src = NULL;
+  return 0;
+}
+int list_unique(dlist_t** lst, int (*predicate)(const void* data1, const void* data2), void (*deleter)(void* data)) {
+  if (!lst || !predicate) return -1;
+
+  *lst = list_front(*lst);
+  return list_unique_chain(*lst, NULL, NULL, NULL, predicate, deleter);
+}
 void list_clear(dlist_t** lst, void (*deleter)(void* data)) {
   if (!lst || !(*lst)) return;
   dlist_t* lst_ = list_front(*lst);
@@ -183,8 +636,10 @@ void list_clear(dlist_t** lst, void (*deleter)(void* data)) {
     dlist_t* tmp = lst_;
     // Set next
     lst_ = lst_->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
     // Delete element
     if (deleter) {
+      LIST_STATS_ADD(deleter_calls, 1);
       deleter(tmp->data);
       tmp->data = NULL;
     } else {
@@ -192,30 +647,77 @@ void list_clear(dlist_t** lst, void (*deleter)(void* data)) {
       free(tmp->data);
       tmp->data = NULL;
     }
+    LIST_STATS_ADD(node_frees, 1);
     free(tmp);
     tmp = NULL;
   }
   *lst = NULL;
 }
+int list_append_array(dlist_t** lst, void* const* data, size_t count) {
+  if (!lst || (!data && count)) return -1;
+  if (!count) return 0;
+
+  dlist_t* last = NULL;
+  dlist_t* first = list_build_chain(NULL, data, count, &last);
+  if (!first) return -1;
+
+  dlist_t* back = list_back(*lst);
+  if (back) {
+    back->next = first;
+    first->prev = back;
+  } else {
+    *lst = first;
+  }
+  return 0;
+}
+int list_concat(dlist_t** dst, dlist_t** src) {
+  if (!dst || !src) return -1;
+  if (!(*src)) return 0;
+
+  dlist_t* first = list_front(*src);
+  // Concatenating a chain to itself would link it into a cycle
+  if (*dst && list_front(*dst) == first) return -1;
+
+  dlist_t* back = list_back(*dst);
+  if (back) {
+    back->next = first;
+    first->prev = back;
+  } else {
+    *dst = first;
+  }
+  *src = NULL;
+  return 0;
+}
 const dlist_t* list_cfront(const dlist_t* lst) {
   if (!lst) return NULL;
 
   const dlist_t* cur = lst;
-  while (cur && (cur->prev)) cur = cur->prev;
+  while (cur && (cur->prev)) {
+    cur = cur->prev;
+    LIST_STATS_ADD(nodes_traversed, 1);
+  }
+  if (cur != lst) LIST_STATS_ADD(rewinds, 1);
   return cur;
 }
 dlist_t* list_front(dlist_t* lst) {
   if (!lst) return NULL;
 
   dlist_t* cur = lst;
-  while (cur && (cur->prev)) cur = cur->prev;
+  while (cur && (cur->prev)) {
+    cur = cur->prev;
+    LIST_STATS_ADD(nodes_traversed, 1);
+  }
+  if (cur != lst) LIST_STATS_ADD(rewinds, 1);
   return cur;
 }
 dlist_t* list_back(dlist_t* lst) {
   if (!lst) return NULL;
 
   dlist_t* cur = lst;
-  while (cur && (cur->next != NULL)) cur = cur->next;
+  while (cur && (cur->next != NULL)) {
+    cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
+  }
   return cur;
 }
 void list_pop_front(dlist_t** lst, void (*deleter)(void* data)) {
@@ -234,6 +736,7 @@ void list_pop_front(dlist_t** lst, void (*deleter)(void* data)) {
   }
   // Delete element
   if (deleter) {
+    LIST_STATS_ADD(deleter_calls, 1);
     deleter(cur->data);
     cur->data = NULL;
   } else {
@@ -241,6 +744,7 @@ void list_pop_front(dlist_t** lst, void (*deleter)(void* data)) {
     free(cur->data);
     cur->data = NULL;
   }
+  LIST_STATS_ADD(node_frees, 1);
   free(cur);
   cur = NULL;
   // Reassign address to the next node
@@ -258,6 +762,7 @@ void list_pop_back(dlist_t** lst, void (*deleter)(void* data)) {
   if (cur->next) return;
   // Delete node
   if (deleter) {
+    LIST_STATS_ADD(deleter_calls, 1);
     deleter(cur->data);
     cur->data = NULL;
   } else {
@@ -265,11 +770,75 @@ void list_pop_back(dlist_t** lst, void (*deleter)(void* data)) {
     free(cur->data);
     cur->data = NULL;
   }
+  LIST_STATS_ADD(node_frees, 1);
   free(cur);
   cur = NULL;
 
   return;
 }
+dlist_t* list_insert_before(dlist_t** lst, dlist_t* pos, void* data) {
+  if (!lst || !data) return NULL;
+  if (!pos) return list_push_back(lst, data);
+
+  dlist_t* node = list_node_alloc(NULL);
+  if (!node) return NULL;
+  node->data = data;
+  node->prev = pos->prev;
+  node->next = pos;
+  if (pos->prev) (pos->prev)->next = node;
+  pos->prev = node;
+  if (*lst == pos) *lst = node;
+  return node;
+}
+dlist_t* list_insert_after(dlist_t** lst, dlist_t* pos, void* data) {
+  if (!lst || !data) return NULL;
+  if (!pos) {
+    dlist_t* first = list_front(*lst);
+    if (!first) return list_push_back(lst, data);
+    return list_insert_before(lst, first, data);
+  }
+  return list_link_after(NULL, pos, data);
+}
+void list_erase(dlist_t** lst, dlist_t* node, void (*deleter)(void* data)) {
+  if (!lst || !node) return;
+
+  // Reassign address node
+  if (node->prev) (node->prev)->next = node->next;
+  if (node->next) (node->next)->prev = node->prev;
+  if (*lst == node) *lst = node->next ? node->next : node->prev;
+  // Delete element
+  list_delete_data(node->data, deleter);
+  list_node_free(NULL, node);
+}
+void list_move_to_front(dlist_t** lst, dlist_t* node) {
+  if (!lst || !node || !*lst) return;
+
+  dlist_t* first = list_front(*lst);
+  if (first == node) {
+    *lst = node;
+    return;
+  }
+  // Unlink, 'node' has a previous node
+  (node->prev)->next = node->next;
+  if (node->next) (node->next)->prev = node->prev;
+  node->prev = NULL;
+  node->next = first;
+  first->prev = node;
+  *lst = node;
+}
+void list_move_to_back(dlist_t** lst, dlist_t* node) {
+  if (!lst || !node || !*lst) return;
+
+  dlist_t* last = list_back(*lst);
+  if (last == node) return;
+  if (*lst == node) *lst = node->next;
+  // Unlink, 'node' has a next node
+  if (node->prev) (node->prev)->next = node->next;
+  (node->next)->prev = node->prev;
+  node->next = NULL;
+  node->prev = last;
+  last->next = node;
+}
 int list_empty(const dlist_t* lst) {
   if (!lst) return 1;
   return 0;
@@ -284,10 +853,399 @@ int list_size(const dlist_t* lst) {
     count++;
     // Set next
     cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
   }
   return count;
 }
 ////////////////////////////////////////////////////////////////////////////
+// List header
+////////////////////////////////////////////////////////////////////////////
+void lst_init(list_t* lst) {
+  if (!lst) return;
+  memset(lst, 0, sizeof(*lst));
+}
+void lst_init_allocator(list_t* lst, const list_allocator_t* allocator) {
+  if (!lst) return;
+  memset(lst, 0, sizeof(*lst));
+  lst->allocator = allocator;
+}
+dlist_t* lst_push_back(list_t* lst, void* data) {
+  if (!lst || !data) return NULL;
+  if (lst->index && list_index_reserve(lst->index, 1)) return NULL;
+
+  dlist_t* node = list_link_after(lst->allocator, lst->tail, data);
+  if (!node) return NULL;
+  if (!lst->head) lst->head = node;
+  lst->tail = node;
+  lst->size++;
+  if (lst->index) list_index_add(lst->index, node);
+  return node;
+}
+dlist_t* lst_push_front(list_t* lst, void* data) {
+  if (!lst || !data) return NULL;
+  if (lst->index && list_index_reserve(lst->index, 1)) return NULL;
+
+  dlist_t* node = list_node_alloc(lst->allocator);
+  if (!node) return NULL;
+  node->data = data;
+  node->next = lst->head;
+  if (lst->head) (lst->head)->prev = node;
+  lst->head = node;
+  if (!lst->tail) lst->tail = node;
+  lst->size++;
+  if (lst->index) list_index_add(lst->index, node);
+  return node;
+}
+void lst_pop_front(list_t* lst, void (*deleter)(void* data)) {
+  if (!lst || !lst->head) return;
+
+  dlist_t* cur = lst->head;
+  // Reassign address node
+  lst->head = cur->next;
+  if (lst->head)
+    (lst->head)->prev = NULL;
+  else
+    lst->tail = NULL;
+  lst->size--;
+  if (lst->index) list_index_del(lst->index, cur);
+  // Delete element
+  list_delete_data(cur->data, deleter);
+  list_node_free(lst->allocator, cur);
+}
+void lst_pop_back(list_t* lst, void (*deleter)(void* data)) {
+  if (!lst || !lst->tail) return;
+
+  dlist_t* cur = lst->tail;
+  // Reassign address node
+  lst->tail = cur->prev;
+  if (lst->tail)
+    (lst->tail)->next = NULL;
+  else
+    lst->head = NULL;
+  lst->size--;
+  if (lst->index) list_index_del(lst->index, cur);
+  // Delete element
+  list_delete_data(cur->data, deleter);
+  list_node_free(lst->allocator, cur);
+}
+dlist_t* lst_insert_before(list_t* lst, dlist_t* pos, void* data) {
+  if (!lst || !data) return NULL;
+  if (lst->index && list_index_reserve(lst->index, 1)) return NULL;
+
+  dlist_t* node = list_node_alloc(lst->allocator);
+  if (!node) return NULL;
+  node->data = data;
+  lst_link_chain(lst, pos, node, node, 1);
+  if (lst->index) list_index_add(lst->index, node);
+  return node;
+}
+dlist_t* lst_insert_after(list_t* lst, dlist_t* pos, void* data) {
+  if (!lst) return NULL;
+  return lst_insert_before(lst, pos ? pos->next : lst->head, data);
+}
+void lst_erase(list_t* lst, dlist_t* node, void (*deleter)(void* data)) {
+  if (!lst || !node) return;
+
+  lst_unlink(lst, node);
+  if (lst->index) list_index_del(lst->index, node);
+  // Delete element
+  list_delete_data(node->data, deleter);
+  list_node_free(lst->allocator, node);
+}
+void lst_move_to_front(list_t* lst, dlist_t* node) {
+  if (!lst || !node || lst->head == node) return;
+
+  lst_unlink(lst, node);
+  lst_link_chain(lst, lst->head, node, node, 1);
+}
+void lst_move_to_back(list_t* lst, dlist_t* node) {
+  if (!lst || !node || lst->tail == node) return;
+
+  lst_unlink(lst, node);
+  lst_link_chain(lst, NULL, node, node, 1);
+}
+dlist_t* lst_front(const list_t* lst) {
+  if (!lst) return NULL;
+  return lst->head;
+}
+dlist_t* lst_back(const list_t* lst) {
+  if (!lst) return NULL;
+  return lst->tail;
+}
+size_t lst_size(const list_t* lst) {
+  if (!lst) return 0;
+  return lst->size;
+}
+int lst_empty(const list_t* lst) {
+  if (!lst || !lst->head) return 1;
+  return 0;
+}
+void lst_clear(list_t* lst, void (*deleter)(void* data)) {
+  if (!lst) return;
+
+  dlist_t* cur = lst->head;
+  while (cur) {
+    dlist_t* tmp = cur;
+    // Set next
+    cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
+    // Delete element
+    list_delete_data(tmp->data, deleter);
+    // Nodes of a releasing allocator go away all at once below
+    if (!lst->allocator || !lst->allocator->release) list_node_free(lst->allocator, tmp);
+  }
+  if (lst->allocator && lst->allocator->release) lst->allocator->release(lst->allocator->ctx);
+  if (lst->index) list_index_reset(lst->index);
+  lst->head = lst->tail = NULL;
+  lst->size = 0;
+}
+void lst_reset(list_t* lst) {
+  if (!lst) return;
+
+  if (lst->allocator && lst->allocator->release) {
+    lst->allocator->release(lst->allocator->ctx);
+  } else {
+    dlist_t* cur = lst->head;
+    while (cur) {
+      dlist_t* tmp = cur;
+      // Set next
+      cur = cur->next;
+      LIST_STATS_ADD(nodes_traversed, 1);
+      list_node_free(lst->allocator, tmp);
+    }
+  }
+  if (lst->index) list_index_reset(lst->index);
+  lst->head = lst->tail = NULL;
+  lst->size = 0;
+}
+int lst_append_array(list_t* lst, void* const* data, size_t count) {
+  if (!lst || (!data && count)) return -1;
+  if (!count) return 0;
+  if (lst->index && list_index_reserve(lst->index, count)) return -1;
+
+  dlist_t* last = NULL;
+  dlist_t* first = list_build_chain(lst->allocator, data, count, &last);
+  if (!first) return -1;
+
+  lst_link_chain(lst, NULL, first, last, count);
+  if (lst->index) {
+    dlist_t* cur = first;
+    while (cur) {
+      list_index_add(lst->index, cur);
+      cur = cur->next;
+    }
+  }
+  return 0;
+}
+int lst_splice(list_t* dst, dlist_t* pos, list_t* src) {
+  if (!dst || !src || dst->allocator != src->allocator) return -1;
+  if (dst == src || !src->head) return 0;
+  if (dst->index && list_index_reserve(dst->index, src->size)) return -1;
+
+  // Indexes are kept up to date node by node, otherwise this is constant time
+  if (dst->index) {
+    dlist_t* cur = src->head;
+    while (cur) {
+      list_index_add(dst->index, cur);
+      cur = cur->next;
+    }
+  }
+  if (src->index) list_index_reset(src->index);
+  lst_link_chain(dst, pos, src->head, src->tail, src->size);
+  src->head = src->tail = NULL;
+  src->size = 0;
+  return 0;
+}
+int lst_splice_range(list_t* dst, dlist_t* pos, list_t* src, dlist_t* first, dlist_t* last) {
+  if (!dst || !src || dst->allocator != src->allocator) return -1;
+  if (!first || first == last) return 0;
+
+  // Whole list
+  if (first == src->head && !last) return lst_splice(dst, pos, src);
+
+  // Count the range, it ends right before 'last'
+  size_t count = 1;
+  dlist_t* end = first;
+  while (end->next != last) {
+    if (!end->next) return -1;  // 'last' does not follow 'first'
+    end = end->next;
+    count++;
+  }
+  if (dst == src) {
+    // Moving a range in front of one of its own nodes
+    dlist_t* cur = first;
+    while (cur != last) {
+      if (cur == pos) return -1;
+      cur = cur->next;
+    }
+  }
+  if (dst != src && dst->index && list_index_reserve(dst->index, count)) return -1;
+  if (dst != src && (dst->index || src->index)) {
+    dlist_t* cur = first;
+    while (cur != last) {
+      if (src->index) list_index_del(src->index, cur);
+      if (dst->index) list_index_add(dst->index, cur);
+      cur = cur->next;
+    }
+  }
+  // Unlink from source
+  if (first->prev)
+    (first->prev)->next = last;
+  else
+    src->head = last;
+  if (last)
+    last->prev = first->prev;
+  else
+    src->tail = first->prev;
+  src->size -= count;
+  // Link into destination
+  lst_link_chain(dst, pos, first, end, count);
+  return 0;
+}
+int lst_concat(list_t* dst, list_t* src) { return lst_splice(dst, NULL, src); }
+int lst_erase_if(list_t* lst, const void* value, int (*predicate)(const void* data1, const void* data2),
+                 void (*deleter)(void* data)) {
+  if (!lst || !predicate) return -1;
+
+  int count = list_erase_chain(&lst->head, &lst->tail, lst->allocator, lst->index, value, predicate, deleter, NULL);
+  lst->size -= (size_t)count;
+  return count;
+}
+int lst_erase_if_batch(list_t* lst, const void* value, int (*predicate)(const void* data1, const void* data2),
+                       void (*deleter_n)(void** data, size_t count)) {
+  if (!lst || !predicate || !deleter_n) return -1;
+
+  int count = list_erase_chain(&lst->head, &lst->tail, lst->allocator, lst->index, value, predicate, NULL, deleter_n);
+  lst->size -= (size_t)count;
+  return count;
+}
+int lst_sort(list_t* lst, int (*compare)(const void* data1, const void* data2)) {
+  if (!lst || !compare) return -1;
+
+  lst->head = list_sort_chain(lst->head, compare);
+  lst->tail = list_relink_prev(lst->head);
+  return 0;
+}
+int lst_merge(list_t* dst, list_t* src, int (*compare)(const void* data1, const void* data2)) {
+  if (!dst || !src || !compare || dst->allocator != src->allocator) return -1;
+  if (dst == src || !src->head) return 0;
+  if (dst->index && list_index_reserve(dst->index, src->size)) return -1;
+
+  if (dst->index) {
+    dlist_t* cur = src->head;
+    while (cur) {
+      list_index_add(dst->index, cur);
+      cur = cur->next;
+    }
+  }
+  if (src->index) list_index_reset(src->index);
+  dst->head = list_merge_chains(dst->head, src->head, compare);
+  dst->tail = list_relink_prev(dst->head);
+  dst->size += src->size;
+  src->head = src->tail = NULL;
+  src->size = 0;
+  return 0;
+}
+int lst_unique(list_t* lst, int (*predicate)(const void* data1, const void* data2), void (*deleter)(void* data)) {
+  if (!lst || !predicate) return -1;
+
+  int count = list_unique_chain(lst->head, &lst->tail, lst->allocator, lst->index, predicate, deleter);
+  lst->size -= (size_t)count;
+  return count;
+}
+int lst_index_enable(list_t* lst, size_t (*hash)(const void* data),
+                     int (*predicate)(const void* data1, const void* data2)) {
+  if (!lst || !hash || !predicate) return -1;
+
+  lst_index_disable(lst);
+  list_index_t* index = (list_index_t*)calloc(1, sizeof(list_index_t));
+  if (!index) return -1;
+  index->hash = hash;
+  index->predicate = predicate;
+  if (list_index_reserve(index, lst->size)) {
+    free(index);
+    return -1;
+  }
+  dlist_t* cur = lst->head;
+  while (cur) {
+    list_index_add(index, cur);
+    // Set next
+    cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
+  }
+  lst->index = index;
+  return 0;
+}
+void lst_index_disable(list_t* lst) {
+  if (!lst || !lst->index) return;
+  free(lst->index->slots);
+  free(lst->index);
+  lst->index = NULL;
+}
+dlist_t* lst_find(list_t* lst, const void* value, int (*predicate)(const void* data1, const void* data2)) {
+  return (dlist_t*)lst_cfind(lst, value, predicate);
+}
+const dlist_t* lst_cfind(const list_t* lst, const void* value,
+                         int (*predicate)(const void* data1, const void* data2)) {
+  if (!lst) return NULL;
+
+  const list_index_t* index = lst->index;
+  if (!index || (predicate && predicate != index->predicate)) return list_cfind(lst->head, value, predicate);
+
+  const list_index_slot_t* slot = list_index_lookup(index, NULL, value, index->hash(value));
+  return slot ? slot->node : NULL;
+}
+int lst_count(const list_t* lst, const void* value, int (*predicate)(const void* data1, const void* data2)) {
+  if (!lst) return -1;
+
+  const list_index_t* index = lst->index;
+  if (!index || (predicate && predicate != index->predicate)) {
+    if (!lst->head) return predicate ? 0 : -1;
+    return list_count(lst->head, value, predicate);
+  }
+
+  int count = 0;
+  size_t hash = index->hash(value);
+  const list_index_slot_t* slot = list_index_lookup(index, NULL, value, hash);
+  while (slot) {
+    count++;
+    slot = list_index_lookup(index, slot, value, hash);
+  }
+  return count;
+}
+int lst_push_back_unique(list_t* lst, const void* value, void* src,
+                         int (*predicate)(const void* data1, const void* data2),
+                         void (*copy)(const void* src_data, void* dst_data), void* (*ctor_copy)(const void* src_data)) {
+  if (!lst || !value || !src) return -1;
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Find element
+  ////////////////////////////////////////////////////////////////////////////
+  const dlist_t* node = lst_cfind(lst, value, predicate);
+
+  // Refresh element
+  if (node) {
+    if (copy) {
+      copy(src, node->data);
+      return 0;
+    }
+  }
+  // Create element
+  else {
+    if (ctor_copy) {
+      void* node_new = ctor_copy(src);
+      if (!node_new) return -1;
+      // Add to list
+      if (!lst_push_back(lst, node_new)) {
+        free(node_new);
+        return -1;
+      }
+      return 0;
+    }
+  }
+  return -1;
+}
+////////////////////////////////////////////////////////////////////////////
 // Algorithms
 ////////////////////////////////////////////////////////////////////////////
 // Applies function fn to each of the elements in the range [first,last).
@@ -299,6 +1257,7 @@ int list_for_each(dlist_t* lst, int (*fn)(void* data)) {
     dlist_t* tmp = cur;
     // Set next
     cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
     if (fn) fn(tmp->data);
   }
   return 0;
@@ -306,26 +1265,41 @@ int list_for_each(dlist_t* lst, int (*fn)(void* data)) {
 int list_for_each_extra(dlist_t* lst, int (*fn)(void* data), int count, ...) {
   if (!lst) return 0;
 
+  // Arguments are the same for every element, parse them once
+  char* buf[count];
+  memset(buf, 0, sizeof(buf));
+  va_list args;
+  va_start(args, count);
+  int i = 0;
+  for (i = 0; i < count; ++i) buf[i] = va_arg(args, char*);
+  va_end(args);
+
   dlist_t* cur = lst;
   while (cur) {
     dlist_t* tmp = cur;
     // Set next
     cur = cur->next;
-    // Call function
+    LIST_STATS_ADD(nodes_traversed, 1);
     if (fn) {
-      char* buf[count];
-      memset(buf, 0, sizeof(buf));
-      va_list args;
-      va_start(args, count);
-      int i = 0;
-      for (i = 0; i < count; ++i) buf[i] = va_arg(args, char*);
-      va_end(args);
       // Call function
       call(fn, count, tmp->data, buf);
     }
   }
   return 0;
 }
+int list_for_each_ctx(dlist_t* lst, int (*fn)(void* data, void* ctx), void* ctx) {
+  if (!lst || !fn) return 0;
+
+  dlist_t* cur = lst;
+  while (cur) {
+    dlist_t* tmp = cur;
+    // Set next
+    cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
+    fn(tmp->data, ctx);
+  }
+  return 0;
+}
 int list_any_of(dlist_t* lst, int (*fn)(void* data)) {
   if (!lst) return 0;
 
@@ -334,6 +1308,7 @@ int list_any_of(dlist_t* lst, int (*fn)(void* data)) {
     dlist_t* tmp = cur;
     // Set next
     cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
     if (fn)
       if (1 == fn(tmp->data)) return 1;
   }
@@ -342,49 +1317,79 @@ int list_any_of(dlist_t* lst, int (*fn)(void* data)) {
 int list_any_of_extra(dlist_t* lst, int (*fn)(void* data), int count, ...) {
   if (!lst) return 0;
 
+  // Arguments are the same for every element, parse them once
+  char* buf[count];
+  memset(buf, 0, sizeof(buf));
+  va_list args;
+  va_start(args, count);
+  int i = 0;
+  for (i = 0; i < count; ++i) buf[i] = va_arg(args, char*);
+  va_end(args);
+
   dlist_t* cur = lst;
   while (cur) {
     dlist_t* tmp = cur;
     // Set next
     cur = cur->next;
-    // Call function
+    LIST_STATS_ADD(nodes_traversed, 1);
     if (fn) {
-      char* buf[count];
-      memset(buf, 0, sizeof(buf));
-      va_list args;
-      va_start(args, count);
-      int i = 0;
-      for (i = 0; i < count; ++i) buf[i] = va_arg(args, char*);
-      va_end(args);
       // Call function
       if (1 == call(fn, count, tmp->data, buf)) return 1;
     }
   }
   return 0;
 }
+int list_any_of_ctx(dlist_t* lst, int (*fn)(void* data, void* ctx), void* ctx) {
+  if (!lst || !fn) return 0;
+
+  dlist_t* cur = lst;
+  while (cur) {
+    dlist_t* tmp = cur;
+    // Set next
+    cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
+    if (1 == fn(tmp->data, ctx)) return 1;
+  }
+  return 0;
+}
 int list_cany_of_extra(const dlist_t* lst, int (*fn)(void* data), int count, ...) {
   if (!lst) return 0;
 
+  // Arguments are the same for every element, parse them once
+  char* buf[count];
+  memset(buf, 0, sizeof(buf));
+  va_list args;
+  va_start(args, count);
+  int i = 0;
+  for (i = 0; i < count; ++i) buf[i] = va_arg(args, char*);
+  va_end(args);
+
   const dlist_t* cur = lst;
   while (cur) {
     const dlist_t* tmp = cur;
     // Set next
     cur = cur->next;
-    // Call function
+    LIST_STATS_ADD(nodes_traversed, 1);
     if (fn) {
-      char* buf[count];
-      memset(buf, 0, sizeof(buf));
-      va_list args;
-      va_start(args, count);
-      int i = 0;
-      for (i = 0; i < count; ++i) buf[i] = va_arg(args, char*);
-      va_end(args);
       // Call function
       if (1 == call(fn, count, tmp->data, buf)) return 1;
     }
   }
   return 0;
 }
+int list_cany_of_ctx(const dlist_t* lst, int (*fn)(void* data, void* ctx), void* ctx) {
+  if (!lst || !fn) return 0;
+
+  const dlist_t* cur = lst;
+  while (cur) {
+    const dlist_t* tmp = cur;
+    // Set next
+    cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
+    if (1 == fn(tmp->data, ctx)) return 1;
+  }
+  return 0;
+}
 int list_all_of(dlist_t* lst, int (*fn)(void* data)) {
   if (!lst) return 1;
 
@@ -393,6 +1398,7 @@ int list_all_of(dlist_t* lst, int (*fn)(void* data)) {
     dlist_t* tmp = cur;
     // Set next
     cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
 
     if (fn)
       if (!fn(tmp->data)) return 0;
@@ -402,26 +1408,41 @@ int list_all_of(dlist_t* lst, int (*fn)(void* data)) {
 int list_all_of_extra(dlist_t* lst, int (*fn)(void* data), int count, ...) {
   if (!lst) return 1;
 
+  // Arguments are the same for every element, parse them once
+  char* buf[count];
+  memset(buf, 0, sizeof(buf));
+  va_list args;
+  va_start(args, count);
+  int i = 0;
+  for (i = 0; i < count; ++i) buf[i] = va_arg(args, char*);
+  va_end(args);
+
   dlist_t* cur = lst;
   while (cur) {
     dlist_t* tmp = cur;
     // Set next
     cur = cur->next;
-    // Call function
+    LIST_STATS_ADD(nodes_traversed, 1);
     if (fn) {
-      char* buf[count];
-      memset(buf, 0, sizeof(buf));
-      va_list args;
-      va_start(args, count);
-      int i = 0;
-      for (i = 0; i < count; ++i) buf[i] = va_arg(args, char*);
-      va_end(args);
       // Call function
       if (!call(fn, count, tmp->data, buf)) return 0;
     }
   }
   return 1;
 }
+int list_all_of_ctx(dlist_t* lst, int (*fn)(void* data, void* ctx), void* ctx) {
+  if (!lst || !fn) return 1;
+
+  dlist_t* cur = lst;
+  while (cur) {
+    dlist_t* tmp = cur;
+    // Set next
+    cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
+    if (!fn(tmp->data, ctx)) return 0;
+  }
+  return 1;
+}
 int list_none_of(dlist_t* lst, int (*fn)(void* data)) {
   if (!lst) return 1;
 
@@ -430,6 +1451,7 @@ int list_none_of(dlist_t* lst, int (*fn)(void* data)) {
     dlist_t* tmp = cur;
     // Set next
     cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
 
     if (fn)
       if (1 == fn(tmp->data)) return 0;
@@ -439,26 +1461,41 @@ int list_none_of(dlist_t* lst, int (*fn)(void* data)) {
 int list_none_of_extra(dlist_t* lst, int (*fn)(void* data), int count, ...) {
   if (!lst) return 1;
 
+  // Arguments are the same for every element, parse them once
+  char* buf[count];
+  memset(buf, 0, sizeof(buf));
+  va_list args;
+  va_start(args, count);
+  int i = 0;
+  for (i = 0; i < count; ++i) buf[i] = va_arg(args, char*);
+  va_end(args);
+
   dlist_t* cur = lst;
   while (cur) {
     dlist_t* tmp = cur;
     // Set next
     cur = cur->next;
-    // Call function
+    LIST_STATS_ADD(nodes_traversed, 1);
     if (fn) {
-      char* buf[count];
-      memset(buf, 0, sizeof(buf));
-      va_list args;
-      va_start(args, count);
-      int i = 0;
-      for (i = 0; i < count; ++i) buf[i] = va_arg(args, char*);
-      va_end(args);
       // Call function
       if (1 == call(fn, count, tmp->data, buf)) return 0;
     }
   }
   return 1;
 }
+int list_none_of_ctx(dlist_t* lst, int (*fn)(void* data, void* ctx), void* ctx) {
+  if (!lst || !fn) return 1;
+
+  dlist_t* cur = lst;
+  while (cur) {
+    dlist_t* tmp = cur;
+    // Set next
+    cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
+    if (1 == fn(tmp->data, ctx)) return 0;
+  }
+  return 1;
+}
 int list_distance(const dlist_t* first1, const dlist_t* last1) {
   if (!first1 || !last1) return -1;
 
@@ -468,6 +1505,7 @@ int list_distance(const dlist_t* first1, const dlist_t* last1) {
     count++;
     // Set next
     cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
   }
   return count;
 }
@@ -482,31 +1520,137 @@ int list_is_permutation(const dlist_t* first1, const dlist_t* first2,
 
   if (!sz1 && !sz2) return 1;  // Have a same elements, because they are zero sizes.
 
+  // Without a predicate no element matches, as list_count would report -1 for both lists
+  if (!predicate) return 0;  // Have NOT a same elements
+
   if (sz1) {
-    const dlist_t* cur = first1;
+    const dlist_t* front1 = list_cfront(first1);
+    const dlist_t* front2 = list_cfront(first2);
+    const dlist_t* cur = front1;
     while (cur) {
       const dlist_t* tmp = cur;
       // Set next
       cur = cur->next;
+      LIST_STATS_ADD(nodes_traversed, 1);
 
-      if (!list_cfind(first2, tmp->data, predicate)) return 0;  // Have NOT a same elements
+      // Elements may repeat, so their multiplicities must match too. Each distinct value is counted once, at its first
+      // occurrence, which also lets the count in the first list start there
+      const dlist_t* seen = front1;
+      while (seen != tmp && 0 != LIST_STATS_CALL(predicate_calls, predicate(seen->data, tmp->data))) {
+        // Set next
+        seen = seen->next;
+        LIST_STATS_ADD(nodes_traversed, 1);
+      }
+      if (seen != tmp) continue;
+      // The sizes are equal, so the second list holding at least as many of every value means it holds exactly as
+      // many, and its scan stops there
+      int count = list_count_from(tmp, tmp->data, predicate, INT_MAX);
+      if (list_count_from(front2, tmp->data, predicate, count) < count) return 0;  // Have NOT a same elements
     }
     return 1;  // Have a same elements
   }
   return 0;  // Have NOT a same elements
 }
+int list_is_permutation_hash(const dlist_t* first1, const dlist_t* first2, size_t (*hash)(const void* data),
+                             int (*predicate)(const void* data1, const void* data2)) {
+  if (!hash || !predicate) return -1;
+
+  first1 = list_cfront(first1);
+  first2 = list_cfront(first2);
+  size_t sz1 = (size_t)list_size(first1);
+  if (sz1 != (size_t)list_size(first2)) return 0;  // Have NOT a same elements
+  if (!sz1) return 1;                              // Have a same elements, because they are zero sizes.
+
+  // Count the elements of the first list, then take the second list off the counts
+  size_t capacity = 16;
+  while (capacity < sz1 * 2) capacity *= 2;
+  size_t mask = capacity - 1;
+  list_multiset_slot_t* slots = (list_multiset_slot_t*)calloc(capacity, sizeof(list_multiset_slot_t));
+  if (!slots) return -1;
+
+  const dlist_t* cur = first1;
+  while (cur) {
+    size_t h = hash(cur->data);
+    size_t pos = h & mask;
+    while (slots[pos].data &&
+           (slots[pos].hash != h || 0 != LIST_STATS_CALL(predicate_calls, predicate(slots[pos].data, cur->data))))
+      pos = (pos + 1) & mask;
+    if (!slots[pos].data) {
+      slots[pos].hash = h;
+      slots[pos].data = cur->data;
+    }
+    slots[pos].count++;
+    // Set next
+    cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
+  }
+  int result = 1;
+  cur = first2;
+  while (cur) {
+    size_t h = hash(cur->data);
+    size_t pos = h & mask;
+    while (slots[pos].data &&
+           (slots[pos].hash != h || 0 != LIST_STATS_CALL(predicate_calls, predicate(slots[pos].data, cur->data))))
+      pos = (pos + 1) & mask;
+    // Sizes are equal, so no count goes below zero only if all counts end at zero
+    if (!slots[pos].data || !slots[pos].count) {
+      result = 0;  // Have NOT a same elements
+      break;
+    }
+    slots[pos].count--;
+    // Set next
+    cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
+  }
+  free(slots);
+  return result;
+}
+int list_is_permutation_cmp(const dlist_t* first1, const dlist_t* first2,
+                            int (*compare)(const void* data1, const void* data2)) {
+  if (!compare) return -1;
+
+  first1 = list_cfront(first1);
+  first2 = list_cfront(first2);
+  size_t sz1 = (size_t)list_size(first1);
+  if (sz1 != (size_t)list_size(first2)) return 0;  // Have NOT a same elements
+  if (!sz1) return 1;                              // Have a same elements, because they are zero sizes.
+
+  // Both sorted element arrays and the merge scratch space
+  void** data1 = (void**)malloc(3 * sz1 * sizeof(void*));
+  if (!data1) return -1;
+  void** data2 = data1 + sz1;
+  void** tmp = data2 + sz1;
+  list_fill_ptrs(first1, data1);
+  list_fill_ptrs(first2, data2);
+  list_sort_ptrs(data1, tmp, sz1, compare);
+  list_sort_ptrs(data2, tmp, sz1, compare);
+
+  int result = 1;
+  size_t i = 0;
+  for (i = 0; i < sz1; i++) {
+    if (0 != compare(data1[i], data2[i])) {
+      result = 0;  // Have NOT a same elements
+      break;
+    }
+  }
+  free(data1);
+  return result;
+}
 int list_copy(const dlist_t* src_lst, dlist_t** dst_lst, void* (*ctor)(size_t count), void (*dtor)(void* data),
               void (*copy)(const void* src_data, void* dst_data)) {
-  if (!ctor || !copy) return -1;
+  if (!dst_lst || !ctor || !copy) return -1;
 
   // Free destination list
   if (dtor) list_clear(dst_lst, dtor);
 
+  // Keep the last node at hand, so each element is linked without walking the destination
+  dlist_t* last = list_back(*dst_lst);
   const dlist_t* cur = src_lst;
   while (cur) {
     const dlist_t* tmp = cur;
     // Set next
     cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
 
     void* src_data = tmp->data;
     void* dst_data = ctor(1);
@@ -516,7 +1660,14 @@ int list_copy(const dlist_t* src_lst, dlist_t** dst_lst, void* (*ctor)(size_t co
     }
     copy(src_data, dst_data);
     // Add to list
-    list_push_back(dst_lst, dst_data);
+    dlist_t* node = list_link_after(NULL, last, dst_data);
+    if (!node) {
+      list_delete_data(dst_data, dtor);
+      list_clear(dst_lst, dtor);
+      return -1;
+    }
+    if (!last) *dst_lst = node;
+    last = node;
   }
   return 0;
 }
@@ -531,8 +1682,9 @@ int list_count(const dlist_t* lst, const void* value, int (*predicate)(const voi
     const dlist_t* tmp = cur;
     // Set next
     cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
 
-    if (0 == predicate(tmp->data, value)) count++;
+    if (0 == LIST_STATS_CALL(predicate_calls, predicate(tmp->data, value))) count++;
   }
   return count;
 }
@@ -544,8 +1696,9 @@ dlist_t* list_find(dlist_t* lst, const void* value, int (*predicate)(const void*
     dlist_t* tmp = cur;
     // Set next
     cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
 
-    if (0 == predicate(tmp->data, value)) return tmp;
+    if (0 == LIST_STATS_CALL(predicate_calls, predicate(tmp->data, value))) return tmp;
   }
   return NULL;
 }
@@ -558,8 +1711,9 @@ const dlist_t* list_cfind(const dlist_t* lst, const void* value,
     const dlist_t* tmp = cur;
     // Set next
     cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
 
-    if (0 == predicate(tmp->data, value)) return tmp;
+    if (0 == LIST_STATS_CALL(predicate_calls, predicate(tmp->data, value))) return tmp;
   }
   return NULL;
 }
@@ -574,8 +1728,9 @@ dlist_t* list_find_end(dlist_t* lst, const void* value, int (*predicate)(const v
     dlist_t* tmp = cur;
     // Set next
     cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
 
-    if (0 == predicate(tmp->data, value)) last = tmp;
+    if (0 == LIST_STATS_CALL(predicate_calls, predicate(tmp->data, value))) last = tmp;
   }
   return last;
 }
@@ -591,8 +1746,9 @@ const dlist_t* list_cfind_end(const dlist_t* lst, const void* value,
     const dlist_t* tmp = cur;
     // Set next
     cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
 
-    if (0 == predicate(tmp->data, value)) last = tmp;
+    if (0 == LIST_STATS_CALL(predicate_calls, predicate(tmp->data, value))) last = tmp;
   }
   return last;
 }
@@ -602,6 +1758,7 @@ void list_traverse(const dlist_t* lst, void (*fn)(const dlist_t* lst, void** dat
     const dlist_t* tmp = cur;
     // Set next
     cur = cur->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
 
     if (fn) fn(tmp, data);
   }
@@ -640,6 +1797,7 @@ uint8_t* transform_lst_to_data_x(const dlist_t* lst, uint8_t** data, size_t* dat
     }
     // Set next
     lst = lst->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
   }
   va_end(vl);
 
@@ -666,6 +1824,8 @@ const uint8_t* transform_data_to_lst_x(const uint8_t* data, size_t* data_sz, dli
   size_t i = 0;
   for (i = 0; i < number_elements; i++) adapters[i] = (adapter)va_arg(vl, int*);
 
+  // Keep the last node at hand, so each element is linked without walking the list
+  dlist_t* last = lst ? list_back(*lst) : NULL;
   while (*data_sz > 0) {
     void* val = calloc(elem_sz, sizeof(uint8_t));
     if (!val) {
@@ -687,14 +1847,244 @@ const uint8_t* transform_data_to_lst_x(const uint8_t* data, size_t* data_sz, dli
       }
     }
     // Set data
-    if (!list_push_back(lst, val)) {
+    dlist_t* node = lst ? list_link_after(NULL, last, val) : NULL;
+    if (!node) {
       // Free memory
       free(val);
       va_end(vl);
       return NULL;
     }
+    if (!last) *lst = node;
+    last = node;
   }
   va_end(vl);
 
   return data;
 }
+size_t transform_lst_size(const dlist_t* lst, const void* (*view)(const void* data, size_t* size)) {
+  if (!view) return 0;
+
+  size_t total = 0;
+  while (lst) {
+    size_t size = 0;
+    view(lst->data, &size);
+    total += list_record_size(size);
+    // Set next
+    lst = lst->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
+  }
+  return total;
+}
+int transform_lst_to_buffer(const dlist_t* lst, uint8_t** data, size_t* data_sz,
+                            const void* (*view)(const void* data, size_t* size)) {
+  if (!data || !data_sz || !view) return -1;
+
+  *data = NULL;
+  *data_sz = transform_lst_size(lst, view);
+  if (*data_sz == 0) return 0;
+  // The padding is written along with the records
+  uint8_t* buf = (uint8_t*)malloc(*data_sz);
+  if (!buf) {
+    *data_sz = 0;
+    return -1;
+  }
+  uint8_t* cur = buf;
+  while (lst) {
+    size_t size = 0;
+    const void* bytes = view(lst->data, &size);
+    size_t record = list_record_size(size);
+    list_put_le64(cur, (uint64_t)size);
+    if (size) memcpy(cur + sizeof(uint64_t), bytes, size);
+    memset(cur + sizeof(uint64_t) + size, 0, record - sizeof(uint64_t) - size);
+    cur += record;
+    // Set next
+    lst = lst->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
+  }
+  *data = buf;
+  return 0;
+}
+struct iovec* transform_lst_to_iovec(const dlist_t* lst, size_t* iov_count,
+                                     const void* (*view)(const void* data, size_t* size)) {
+  if (!iov_count || !view) return NULL;
+
+  *iov_count = 0;
+  size_t count = (size_t)list_size(lst);
+  if (count == 0) return NULL;
+  // Each record takes the padding of the previous one with its prefix, then its payload; one last entry pads the end.
+  // Prefix blocks are LIST_RECORD_ALIGN zero bytes followed by the prefix, so the padding is the tail of those zeros
+  size_t block = LIST_RECORD_ALIGN + sizeof(uint64_t);
+  struct iovec* iov = (struct iovec*)malloc((2 * count + 1) * sizeof(struct iovec) + (count + 1) * block);
+  if (!iov) return NULL;
+  uint8_t* blocks = (uint8_t*)(iov + 2 * count + 1);
+  memset(blocks, 0, (count + 1) * block);
+
+  size_t n = 0, pad = 0;
+  uint8_t* cur = blocks;
+  while (lst) {
+    size_t size = 0;
+    const void* bytes = view(lst->data, &size);
+    list_put_le64(cur + LIST_RECORD_ALIGN, (uint64_t)size);
+    iov[n].iov_base = cur + LIST_RECORD_ALIGN - pad;
+    iov[n++].iov_len = pad + sizeof(uint64_t);
+    if (size) {
+      iov[n].iov_base = (void*)bytes;
+      iov[n++].iov_len = size;
+    }
+    pad = list_record_size(size) - sizeof(uint64_t) - size;
+    cur += block;
+    // Set next
+    lst = lst->next;
+    LIST_STATS_ADD(nodes_traversed, 1);
+  }
+  if (pad) {
+    iov[n].iov_base = cur;
+    iov[n++].iov_len = pad;
+  }
+  *iov_count = n;
+  return iov;
+}
+int transform_buffer_to_lst(const uint8_t* data, size_t data_sz, dlist_t** lst,
+                            void* (*make)(const void* bytes, size_t size)) {
+  if (!lst || (!data && data_sz)) return -1;
+
+  // Keep the last node at hand, so each element is linked without walking the list
+  dlist_t* last = list_back(*lst);
+  while (data_sz > 0) {
+    if (data_sz < sizeof(uint64_t)) return -1;
+    uint64_t size = list_get_le64(data);
+    if (size > data_sz - sizeof(uint64_t)) return -1;
+    size_t record = list_record_size((size_t)size);
+    // The padding of the last record may be cut off
+    if (record > data_sz) record = data_sz;
+
+    void* val = NULL;
+    if (make) {
+      val = make(data + sizeof(uint64_t), (size_t)size);
+    } else {
+      val = malloc(size ? (size_t)size : 1);
+      if (val && size) memcpy(val, data + sizeof(uint64_t), (size_t)size);
+    }
+    if (!val) return -1;
+    dlist_t* node = list_link_after(NULL, last, val);
+    if (!node) {
+      // Free memory
+      free(val);
+      return -1;
+    }
+    if (!last) *lst = node;
+    last = node;
+    data += record;
+    data_sz -= record;
+  }
+  return 0;
+}
+void list_decoder_init(list_decoder_t* decoder, dlist_t** lst, void* (*make)(const void* bytes, size_t size),
+                       size_t max_record) {
+  if (!decoder) return;
+
+  memset(decoder, 0, sizeof(list_decoder_t));
+  decoder->lst = lst;
+  decoder->last = lst ? list_back(*lst) : NULL;
+  decoder->make = make;
+  decoder->max_record = max_record;
+  decoder->error = lst ? 0 : -1;
+}
+int list_decoder_feed(list_decoder_t* decoder, const uint8_t* data, size_t data_sz) {
+  if (!decoder || decoder->error || (!data && data_sz)) return -1;
+
+  int count = 0;
+  while (data_sz > 0) {
+    if (decoder->pad) {
+      size_t n = decoder->pad < data_sz ? decoder->pad : data_sz;
+      decoder->pad -= n;
+      data += n;
+      data_sz -= n;
+      continue;
+    }
+    if (decoder->prefix_len == 0 && data_sz >= sizeof(uint64_t)) {
+      // Whole record in the chunk: built straight from it
+      uint64_t size = list_get_le64(data);
+      if (size <= data_sz - sizeof(uint64_t) && (!decoder->max_record || size <= decoder->max_record)) {
+        if (list_decoder_emit(decoder, data + sizeof(uint64_t), (size_t)size)) {
+          decoder->error = -1;
+          break;
+        }
+        count++;
+        size_t record = list_record_size((size_t)size);
+        if (record > data_sz) {
+          decoder->pad = record - data_sz;
+          record = data_sz;
+        }
+        data += record;
+        data_sz -= record;
+        continue;
+      }
+    }
+    if (decoder->prefix_len < sizeof(uint64_t)) {
+      size_t n = sizeof(uint64_t) - decoder->prefix_len;
+      if (n > data_sz) n = data_sz;
+      memcpy(decoder->prefix + decoder->prefix_len, data, n);
+      decoder->prefix_len += n;
+      data += n;
+      data_sz -= n;
+      if (decoder->prefix_len < sizeof(uint64_t)) break;
+
+      decoder->size = list_get_le64(decoder->prefix);
+      decoder->buffer_len = 0;
+      if ((decoder->max_record && decoder->size > decoder->max_record) || decoder->size > SIZE_MAX / 2) {
+        decoder->error = -1;
+        break;
+      }
+      if (decoder->size > decoder->buffer_capacity) {
+        uint8_t* buffer = (uint8_t*)realloc(decoder->buffer, (size_t)decoder->size);
+        if (!buffer) {
+          decoder->error = -1;
+          break;
+        }
+        decoder->buffer = buffer;
+        decoder->buffer_capacity = (size_t)decoder->size;
+      }
+    }
+    size_t n = (size_t)decoder->size - decoder->buffer_len;
+    if (n > data_sz) n = data_sz;
+    if (n) memcpy(decoder->buffer + decoder->buffer_len, data, n);
+    decoder->buffer_len += n;
+    data += n;
+    data_sz -= n;
+    if (decoder->buffer_len < decoder->size) continue;
+
+    if (list_decoder_emit(decoder, decoder->buffer, decoder->buffer_len)) {
+      decoder->error = -1;
+      break;
+    }
+    count++;
+    decoder->prefix_len = 0;
+    decoder->pad = list_record_size(decoder->buffer_len) - sizeof(uint64_t) - decoder->buffer_len;
+  }
+  return decoder->error ? -1 : count;
+}
+int list_decoder_finish(list_decoder_t* decoder) {
+  if (!decoder) return -1;
+
+  free(decoder->buffer);
+  decoder->buffer = NULL;
+  decoder->buffer_len = decoder->buffer_capacity = 0;
+  // The padding of the last record may be cut off
+  return decoder->error || decoder->prefix_len ? -1 : 0;
+}
+int list_stats_snapshot(list_stats_t* stats) {
+  if (!stats) return -1;
+#ifdef LIST_STATS
+  *stats = list_stats;
+  return 0;
+#else
+  memset(stats, 0, sizeof(list_stats_t));
+  return -1;
+#endif
+}
+void list_stats_reset(void) {
+#ifdef LIST_STATS
+  memset(&list_stats, 0, sizeof(list_stats_t));
+#endif
+}
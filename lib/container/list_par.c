@@ -0,0 +1,226 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "container/list_par.h"
+
+// Tasks per worker, more tasks balance better, fewer tasks cost less to hand out
+#define LIST_PAR_TASKS_PER_THREAD 8
+
+typedef enum list_par_op_t {
+  LIST_PAR_FOR_EACH,
+  LIST_PAR_ANY_OF,
+  LIST_PAR_ALL_OF,
+  LIST_PAR_COUNT,
+  LIST_PAR_FIND,
+} list_par_op_t;
+
+// Shared state of a parallel algorithm
+typedef struct list_par_job_t {
+  list_par_op_t op;
+  dlist_t** starts;     // First node of every grain
+  size_t grains;        // Number of grains
+  size_t grains_per_task;
+  int (*fn)(void* data);
+  const void* value;
+  int (*predicate)(const void* data1, const void* data2);
+  atomic_int stop;      // any_of/all_of decided
+  atomic_size_t first;  // Lowest task with a match (find)
+  atomic_int count;
+  dlist_t** found;      // First match of every task (find)
+} list_par_job_t;
+////////////////////////////////////////////////////////////////////////////
+// Private functions
+////////////////////////////////////////////////////////////////////////////
+static dlist_t** list_par_cut(dlist_t* lst, size_t* grains);
+static void list_par_task(void* arg, size_t task);
+static int list_par_run(thread_pool_t* pool, list_par_job_t* job, dlist_t* lst);
+// Collect the first node of every grain of LIST_PAR_GRAIN nodes
+static dlist_t** list_par_cut(dlist_t* lst, size_t* grains) {
+  size_t capacity = 64, count = 0, hops = 0;
+  dlist_t** starts = (dlist_t**)malloc(capacity * sizeof(dlist_t*));
+  if (!starts) return NULL;
+
+  while (lst) {
+    if (hops++ % LIST_PAR_GRAIN == 0) {
+      if (count == capacity) {
+        dlist_t** tmp = (dlist_t**)realloc(starts, capacity * 2 * sizeof(dlist_t*));
+        if (!tmp) {
+          free(starts);
+          return NULL;
+        }
+        starts = tmp;
+        capacity *= 2;
+      }
+      starts[count++] = lst;
+    }
+    // Set next
+    lst = lst->next;
+  }
+  *grains = count;
+  return starts;
+}
+// Atomically lower 'first' to 'task'
+static void list_par_lower(atomic_size_t* first, size_t task) {
+  size_t cur = atomic_load_explicit(first, memory_order_relaxed);
+  while (task < cur && !atomic_compare_exchange_weak_explicit(first, &cur, task, memory_order_relaxed,
+                                                               memory_order_relaxed)) {
+  }
+}
+static void list_par_task(void* arg, size_t task) {
+  list_par_job_t* job = (list_par_job_t*)arg;
+  size_t grain = task * job->grains_per_task;
+  size_t grain_end = grain + job->grains_per_task;
+  if (grain_end > job->grains) grain_end = job->grains;
+  dlist_t* cur = job->starts[grain];
+  const dlist_t* end = grain_end < job->grains ? job->starts[grain_end] : NULL;
+
+  int count = 0;
+  while (cur != end) {
+    dlist_t* tmp = cur;
+    // Set next
+    cur = cur->next;
+    switch (job->op) {
+      case LIST_PAR_FOR_EACH:
+        job->fn(tmp->data);
+        break;
+      case LIST_PAR_ANY_OF:
+        if (atomic_load_explicit(&job->stop, memory_order_relaxed)) return;
+        if (1 == job->fn(tmp->data)) {
+          atomic_store_explicit(&job->stop, 1, memory_order_relaxed);
+          return;
+        }
+        break;
+      case LIST_PAR_ALL_OF:
+        if (atomic_load_explicit(&job->stop, memory_order_relaxed)) return;
+        if (!job->fn(tmp->data)) {
+          atomic_store_explicit(&job->stop, 1, memory_order_relaxed);
+          return;
+        }
+        break;
+      case LIST_PAR_COUNT:
+        if (0 == job->predicate(tmp->data, job->value)) count++;
+        break;
+      case LIST_PAR_FIND:
+        // An earlier segment already matched
+        if (atomic_load_explicit(&job->first, memory_order_relaxed) < task) return;
+        if (0 == job->predicate(tmp->data, job->value)) {
+          job->found[task] = tmp;
+          list_par_lower(&job->first, task);
+          return;
+        }
+        break;
+    }
+  }
+  if (count) atomic_fetch_add_explicit(&job->count, count, memory_order_relaxed);
+}
+// Cut the list into tasks and run them on the pool
+static int list_par_run(thread_pool_t* pool, list_par_job_t* job, dlist_t* lst) {
+  atomic_init(&job->stop, 0);
+  atomic_init(&job->first, SIZE_MAX);
+  atomic_init(&job->count, 0);
+  job->found = NULL;
+  job->starts = list_par_cut(lst, &job->grains);
+  if (!job->starts) return -1;
+  if (!job->grains) {
+    free(job->starts);
+    return 0;
+  }
+
+  size_t tasks = thread_pool_size(pool) * LIST_PAR_TASKS_PER_THREAD;
+  job->grains_per_task = (job->grains + tasks - 1) / tasks;
+  tasks = (job->grains + job->grains_per_task - 1) / job->grains_per_task;
+  if (job->op == LIST_PAR_FIND) {
+    job->found = (dlist_t**)calloc(tasks, sizeof(dlist_t*));
+    if (!job->found) {
+      free(job->starts);
+      return -1;
+    }
+  }
+  int rc = thread_pool_run(pool, list_par_task, job, tasks);
+  free(job->starts);
+  return rc;
+}
+////////////////////////////////////////////////////////////////////////////
+// Public functions
+////////////////////////////////////////////////////////////////////////////
+int list_par_for_each(thread_pool_t* pool, dlist_t* lst, int (*fn)(void* data)) {
+  if (!pool) return list_for_each(lst, fn);
+  if (!lst || !fn) return 0;
+
+  list_par_job_t job;
+  job.op = LIST_PAR_FOR_EACH;
+  job.fn = fn;
+  return list_par_run(pool, &job, lst);
+}
+int list_par_any_of(thread_pool_t* pool, dlist_t* lst, int (*fn)(void* data)) {
+  if (!pool) return list_any_of(lst, fn);
+  if (!lst || !fn) return 0;
+
+  list_par_job_t job;
+  job.op = LIST_PAR_ANY_OF;
+  job.fn = fn;
+  if (list_par_run(pool, &job, lst)) return -1;
+  return atomic_load(&job.stop);
+}
+int list_par_all_of(thread_pool_t* pool, dlist_t* lst, int (*fn)(void* data)) {
+  if (!pool) return list_all_of(lst, fn);
+  if (!lst || !fn) return 1;
+
+  list_par_job_t job;
+  job.op = LIST_PAR_ALL_OF;
+  job.fn = fn;
+  if (list_par_run(pool, &job, lst)) return -1;
+  return !atomic_load(&job.stop);
+}
+int list_par_count(thread_pool_t* pool, const dlist_t* lst, const void* value,
+                   int (*predicate)(const void* data1, const void* data2)) {
+  if (!pool) return list_count(lst, value, predicate);
+  if (!predicate || !lst) return -1;
+
+  list_par_job_t job;
+  job.op = LIST_PAR_COUNT;
+  job.value = value;
+  job.predicate = predicate;
+  // The nodes are only read
+  if (list_par_run(pool, &job, (dlist_t*)list_cfront(lst))) return -1;
+  return atomic_load(&job.count);
+}
+dlist_t* list_par_find(thread_pool_t* pool, dlist_t* lst, const void* value,
+                       int (*predicate)(const void* data1, const void* data2)) {
+  if (!pool) return list_find(lst, value, predicate);
+  if (!predicate || !lst) return NULL;
+
+  list_par_job_t job;
+  job.op = LIST_PAR_FIND;
+  job.value = value;
+  job.predicate = predicate;
+  if (list_par_run(pool, &job, list_front(lst))) return NULL;
+
+  dlist_t* found = NULL;
+  size_t first = atomic_load(&job.first);
+  if (first != SIZE_MAX) found = job.found[first];
+  free(job.found);
+  return found;
+}
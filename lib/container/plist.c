@@ -0,0 +1,218 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "container/plist.h"
+
+#define PLIST_BYTE_ORDER 0x01020304u
+
+////////////////////////////////////////////////////////////////////////////
+// Private functions
+////////////////////////////////////////////////////////////////////////////
+static size_t plist_record_size(size_t size);
+static const plist_node_t* plist_node_at(const plist_t* plst, uint64_t offset);
+static int plist_check_header(const plist_t* plst);
+// Bytes taken by a node holding 'size' element bytes
+static size_t plist_record_size(size_t size) {
+  return sizeof(plist_node_t) + ((size + PLIST_ALIGN - 1) & ~(size_t)(PLIST_ALIGN - 1));
+}
+// Node at 'offset', or null if it does not fit in the file
+static const plist_node_t* plist_node_at(const plist_t* plst, uint64_t offset) {
+  if (offset < sizeof(plist_header_t) || offset % PLIST_ALIGN || offset > plst->size - sizeof(plist_node_t))
+    return NULL;
+  const plist_node_t* node = (const plist_node_t*)(plst->base + offset);
+  if (node->size > plst->size - offset - sizeof(plist_node_t)) return NULL;
+  return node;
+}
+// Check that the count fits in the file and that the ends are consistent with it. With the count bounded by the file
+// size, the traversals below, which stop after 'count' nodes, end quickly whatever the links say.
+static int plist_check_header(const plist_t* plst) {
+  const plist_header_t* header = (const plist_header_t*)plst->base;
+  if (header->count > (plst->size - sizeof(plist_header_t)) / sizeof(plist_node_t)) return -1;
+  if (!header->count) return header->first || header->last ? -1 : 0;
+
+  const plist_node_t* first = plist_node_at(plst, header->first);
+  const plist_node_t* last = plist_node_at(plst, header->last);
+  if (!first || !last || first->prev || last->next) return -1;
+  if (header->count == 1 && header->first != header->last) return -1;
+  return 0;
+}
+////////////////////////////////////////////////////////////////////////////
+// Public functions
+////////////////////////////////////////////////////////////////////////////
+int plist_write(const char* path, const dlist_t* lst, const void* (*view)(const void* data, size_t* size)) {
+  if (!path || !view) return -1;
+
+  FILE* file = fopen(path, "wb");
+  if (!file) return -1;
+
+  plist_header_t header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, PLIST_MAGIC, sizeof(PLIST_MAGIC));
+  header.version = PLIST_VERSION;
+  header.byte_order = PLIST_BYTE_ORDER;
+  // Nodes are laid out in list order, so every offset is known while writing
+  uint64_t offset = sizeof(plist_header_t), prev = 0;
+  const dlist_t* cur = lst;
+  while (cur) {
+    size_t size = 0;
+    view(cur->data, &size);
+    header.count++;
+    header.last = offset;
+    offset += plist_record_size(size);
+    // Set next
+    cur = cur->next;
+  }
+  header.first = header.count ? sizeof(plist_header_t) : 0;
+  header.file_sz = offset;
+
+  static const uint8_t zeros[PLIST_ALIGN] = {0};
+  int rc = fwrite(&header, sizeof(header), 1, file) == 1 ? 0 : -1;
+  offset = sizeof(plist_header_t);
+  cur = lst;
+  while (cur && rc == 0) {
+    size_t size = 0;
+    const void* bytes = view(cur->data, &size);
+    size_t record = plist_record_size(size);
+    plist_node_t node;
+    node.next = cur->next ? offset + record : 0;
+    node.prev = prev;
+    node.size = size;
+    if (fwrite(&node, sizeof(node), 1, file) != 1 || (size && fwrite(bytes, size, 1, file) != 1) ||
+        (record - sizeof(node) - size && fwrite(zeros, record - sizeof(node) - size, 1, file) != 1))
+      rc = -1;
+    prev = offset;
+    offset += record;
+    // Set next
+    cur = cur->next;
+  }
+  if (fclose(file) != 0) rc = -1;
+  return rc;
+}
+int plist_open(plist_t* plst, const char* path) {
+  if (!plst || !path) return -1;
+
+  plst->base = NULL;
+  plst->size = 0;
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) return -1;
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(plist_header_t)) {
+    close(fd);
+    return -1;
+  }
+  void* base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file
+  close(fd);
+  if (base == MAP_FAILED) return -1;
+
+  const plist_header_t* header = (const plist_header_t*)base;
+  if (memcmp(header->magic, PLIST_MAGIC, sizeof(PLIST_MAGIC)) != 0 || header->version != PLIST_VERSION ||
+      header->byte_order != PLIST_BYTE_ORDER || header->file_sz != (uint64_t)st.st_size) {
+    munmap(base, (size_t)st.st_size);
+    return -1;
+  }
+  plst->base = (const uint8_t*)base;
+  plst->size = (size_t)st.st_size;
+  if (plist_check_header(plst)) {
+    plist_close(plst);
+    return -1;
+  }
+  return 0;
+}
+void plist_close(plist_t* plst) {
+  if (!plst || !plst->base) return;
+
+  munmap((void*)plst->base, plst->size);
+  plst->base = NULL;
+  plst->size = 0;
+}
+size_t plist_size(const plist_t* plst) {
+  return plst && plst->base ? (size_t)((const plist_header_t*)plst->base)->count : 0;
+}
+int plist_empty(const plist_t* plst) { return plist_size(plst) == 0; }
+const plist_node_t* plist_front(const plist_t* plst) {
+  if (!plst || !plst->base) return NULL;
+  return plist_node_at(plst, ((const plist_header_t*)plst->base)->first);
+}
+const plist_node_t* plist_back(const plist_t* plst) {
+  if (!plst || !plst->base) return NULL;
+  return plist_node_at(plst, ((const plist_header_t*)plst->base)->last);
+}
+const plist_node_t* plist_next(const plist_t* plst, const plist_node_t* node) {
+  if (!plst || !node) return NULL;
+  return plist_node_at(plst, node->next);
+}
+const plist_node_t* plist_prev(const plist_t* plst, const plist_node_t* node) {
+  if (!plst || !node) return NULL;
+  return plist_node_at(plst, node->prev);
+}
+const void* plist_data(const plist_node_t* node, size_t* size) {
+  if (!node) return NULL;
+  if (size) *size = (size_t)node->size;
+  return node + 1;
+}
+void plist_for_each(const plist_t* plst, int (*fn)(const void* data, void* ctx), void* ctx) {
+  if (!fn) return;
+
+  // Bounded by the element count, a damaged file cannot loop forever
+  size_t left = plist_size(plst);
+  const plist_node_t* cur = plist_front(plst);
+  while (cur && left--) {
+    fn(cur + 1, ctx);
+    // Set next
+    cur = plist_next(plst, cur);
+  }
+}
+int plist_count(const plist_t* plst, const void* value, int (*predicate)(const void* data1, const void* data2)) {
+  if (!plst || !predicate) return -1;
+
+  int count = 0;
+  // Bounded by the element count, a damaged file cannot loop forever
+  size_t left = plist_size(plst);
+  const plist_node_t* cur = plist_front(plst);
+  while (cur && left--) {
+    if (0 == predicate(cur + 1, value)) count++;
+    // Set next
+    cur = plist_next(plst, cur);
+  }
+  return count;
+}
+const plist_node_t* plist_find(const plist_t* plst, const void* value,
+                               int (*predicate)(const void* data1, const void* data2)) {
+  if (!predicate) return NULL;
+
+  // Bounded by the element count, a damaged file cannot loop forever
+  size_t left = plist_size(plst);
+  const plist_node_t* cur = plist_front(plst);
+  while (cur && left--) {
+    if (0 == predicate(cur + 1, value)) return cur;
+    // Set next
+    cur = plist_next(plst, cur);
+  }
+  return NULL;
+}
@@ -0,0 +1,276 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "container/skiplist.h"
+
+// 'head' has SKIPLIST_MAX_LEVEL links and no element, it is rank 0. A link to null spans up to the end of the list.
+struct skiplist_t {
+  skiplist_node_t* head;
+  size_t level;
+  size_t size;
+  uint64_t seed;
+  int (*compare)(const void* data1, const void* data2);
+};
+
+////////////////////////////////////////////////////////////////////////////
+// Private functions
+////////////////////////////////////////////////////////////////////////////
+static void skiplist_delete_data(void* data, void (*deleter)(void* data));
+static skiplist_node_t* skiplist_node_create(void* data, size_t level);
+static size_t skiplist_random_level(skiplist_t* sl);
+static skiplist_node_t* skiplist_search(const skiplist_t* sl, const void* value, int inclusive,
+                                        skiplist_node_t** update, size_t* rank);
+static void skiplist_unlink(skiplist_t* sl, skiplist_node_t* node, skiplist_node_t** update);
+static void skiplist_delete_data(void* data, void (*deleter)(void* data)) {
+  if (deleter)
+    deleter(data);
+  else
+    free(data);
+}
+static skiplist_node_t* skiplist_node_create(void* data, size_t level) {
+  skiplist_node_t* node =
+      (skiplist_node_t*)calloc(1, sizeof(skiplist_node_t) + level * sizeof(struct skiplist_link_t));
+  if (!node) return NULL;
+  node->data = data;
+  node->level = level;
+  return node;
+}
+// Level of a new node, each level up with probability 1/4
+static size_t skiplist_random_level(skiplist_t* sl) {
+  // xorshift64
+  sl->seed ^= sl->seed << 13;
+  sl->seed ^= sl->seed >> 7;
+  sl->seed ^= sl->seed << 17;
+  size_t level = 1 + (size_t)__builtin_ctzll(sl->seed | (UINT64_C(1) << 62)) / 2;
+  return level < SKIPLIST_MAX_LEVEL ? level : SKIPLIST_MAX_LEVEL;
+}
+// Descend to the last node before the position of 'value': the last node less than it, or not greater than it when
+// 'inclusive'. The last node visited at each level goes to 'update' and the rank of the result to 'rank' (both
+// optional).
+static skiplist_node_t* skiplist_search(const skiplist_t* sl, const void* value, int inclusive,
+                                        skiplist_node_t** update, size_t* rank) {
+  skiplist_node_t* cur = sl->head;
+  size_t pos = 0, i = sl->level;
+  while (i--) {
+    while (cur->links[i].next) {
+      int cmp = sl->compare(cur->links[i].next->data, value);
+      if (cmp > 0 || (cmp == 0 && !inclusive)) break;
+      pos += cur->links[i].span;
+      // Set next
+      cur = cur->links[i].next;
+    }
+    if (update) update[i] = cur;
+  }
+  if (rank) *rank = pos;
+  return cur;
+}
+// Unlink 'node', 'update' holds its predecessor at every level of the list
+static void skiplist_unlink(skiplist_t* sl, skiplist_node_t* node, skiplist_node_t** update) {
+  size_t i = 0;
+  for (i = 0; i < sl->level; i++) {
+    if (update[i]->links[i].next == node) {
+      update[i]->links[i].span += node->links[i].span - 1;
+      update[i]->links[i].next = node->links[i].next;
+    } else {
+      update[i]->links[i].span--;
+    }
+  }
+  while (sl->level > 1 && !sl->head->links[sl->level - 1].next) sl->level--;
+  sl->size--;
+}
+////////////////////////////////////////////////////////////////////////////
+// Public functions
+////////////////////////////////////////////////////////////////////////////
+skiplist_t* skiplist_create(int (*compare)(const void* data1, const void* data2)) {
+  if (!compare) return NULL;
+
+  skiplist_t* sl = (skiplist_t*)calloc(1, sizeof(skiplist_t));
+  if (!sl) return NULL;
+  sl->head = skiplist_node_create(NULL, SKIPLIST_MAX_LEVEL);
+  if (!sl->head) {
+    free(sl);
+    return NULL;
+  }
+  sl->level = 1;
+  sl->seed = UINT64_C(0x9E3779B97F4A7C15);
+  sl->compare = compare;
+  return sl;
+}
+void skiplist_destroy(skiplist_t* sl, void (*deleter)(void* data)) {
+  if (!sl) return;
+
+  skiplist_clear(sl, deleter);
+  free(sl->head);
+  free(sl);
+}
+skiplist_node_t* skiplist_insert(skiplist_t* sl, void* data) {
+  if (!sl) return NULL;
+
+  skiplist_node_t* update[SKIPLIST_MAX_LEVEL];
+  size_t rank[SKIPLIST_MAX_LEVEL];
+  // Descend as skiplist_search, keeping the rank reached at every level
+  skiplist_node_t* cur = sl->head;
+  size_t i = sl->level;
+  while (i--) {
+    rank[i] = i + 1 == sl->level ? 0 : rank[i + 1];
+    while (cur->links[i].next && sl->compare(cur->links[i].next->data, data) <= 0) {
+      rank[i] += cur->links[i].span;
+      // Set next
+      cur = cur->links[i].next;
+    }
+    update[i] = cur;
+  }
+  size_t level = skiplist_random_level(sl);
+  skiplist_node_t* node = skiplist_node_create(data, level);
+  if (!node) return NULL;
+  for (i = sl->level; i < level; i++) {
+    rank[i] = 0;
+    update[i] = sl->head;
+    sl->head->links[i].span = sl->size;
+  }
+  if (level > sl->level) sl->level = level;
+
+  for (i = 0; i < level; i++) {
+    node->links[i].next = update[i]->links[i].next;
+    update[i]->links[i].next = node;
+    node->links[i].span = update[i]->links[i].span - (rank[0] - rank[i]);
+    update[i]->links[i].span = rank[0] - rank[i] + 1;
+  }
+  // Links passing over the new node span one more step
+  for (i = level; i < sl->level; i++) update[i]->links[i].span++;
+  sl->size++;
+  return node;
+}
+skiplist_node_t* skiplist_find(const skiplist_t* sl, const void* value) {
+  skiplist_node_t* node = skiplist_lower_bound(sl, value);
+  return node && 0 == sl->compare(node->data, value) ? node : NULL;
+}
+int skiplist_erase(skiplist_t* sl, const void* value, void (*deleter)(void* data)) {
+  if (!sl) return 0;
+
+  skiplist_node_t* update[SKIPLIST_MAX_LEVEL];
+  skiplist_node_t* node = skiplist_search(sl, value, 0, update, NULL)->links[0].next;
+  if (!node || 0 != sl->compare(node->data, value)) return 0;
+  skiplist_unlink(sl, node, update);
+  skiplist_delete_data(node->data, deleter);
+  free(node);
+  return 1;
+}
+void skiplist_pop_front(skiplist_t* sl, void (*deleter)(void* data)) {
+  if (!sl || !sl->size) return;
+
+  skiplist_node_t* update[SKIPLIST_MAX_LEVEL];
+  skiplist_node_t* node = sl->head->links[0].next;
+  size_t i = 0;
+  for (i = 0; i < sl->level; i++) update[i] = sl->head;
+  skiplist_unlink(sl, node, update);
+  skiplist_delete_data(node->data, deleter);
+  free(node);
+}
+skiplist_node_t* skiplist_lower_bound(const skiplist_t* sl, const void* value) {
+  if (!sl) return NULL;
+  return skiplist_search(sl, value, 0, NULL, NULL)->links[0].next;
+}
+skiplist_node_t* skiplist_upper_bound(const skiplist_t* sl, const void* value) {
+  if (!sl) return NULL;
+  return skiplist_search(sl, value, 1, NULL, NULL)->links[0].next;
+}
+skiplist_node_t* skiplist_at(const skiplist_t* sl, size_t pos) {
+  if (!sl || pos >= sl->size) return NULL;
+
+  // Ranks start at 1 for the first element
+  skiplist_node_t* cur = sl->head;
+  size_t rank = 0, i = sl->level;
+  while (i--) {
+    while (cur->links[i].next && rank + cur->links[i].span <= pos + 1) {
+      rank += cur->links[i].span;
+      // Set next
+      cur = cur->links[i].next;
+    }
+    if (rank == pos + 1) return cur;
+  }
+  return NULL;
+}
+size_t skiplist_rank(const skiplist_t* sl, const void* value) {
+  if (!sl) return 0;
+
+  size_t rank = 0;
+  skiplist_search(sl, value, 0, NULL, &rank);
+  return rank;
+}
+skiplist_node_t* skiplist_front(const skiplist_t* sl) {
+  if (!sl) return NULL;
+  return sl->head->links[0].next;
+}
+skiplist_node_t* skiplist_next(const skiplist_node_t* node) {
+  if (!node) return NULL;
+  return node->links[0].next;
+}
+int skiplist_for_range(const skiplist_t* sl, const void* first, const void* last, int (*fn)(void* data, void* ctx),
+                       void* ctx) {
+  if (!sl || !fn) return -1;
+
+  skiplist_node_t* cur = first ? skiplist_lower_bound(sl, first) : skiplist_front(sl);
+  while (cur && (!last || sl->compare(cur->data, last) < 0)) {
+    fn(cur->data, ctx);
+    // Set next
+    cur = cur->links[0].next;
+  }
+  return 0;
+}
+void skiplist_traverse(const skiplist_node_t* first, const skiplist_node_t* last,
+                       void (*fn)(const skiplist_node_t* node, void** data), void** data) {
+  const skiplist_node_t* cur = first;
+  while (cur && cur != last) {
+    const skiplist_node_t* tmp = cur;
+    // Set next
+    cur = cur->links[0].next;
+
+    if (fn) fn(tmp, data);
+  }
+}
+void skiplist_clear(skiplist_t* sl, void (*deleter)(void* data)) {
+  if (!sl) return;
+
+  skiplist_node_t* cur = sl->head->links[0].next;
+  while (cur) {
+    skiplist_node_t* tmp = cur;
+    // Set next
+    cur = cur->links[0].next;
+    skiplist_delete_data(tmp->data, deleter);
+    free(tmp);
+  }
+  size_t i = 0;
+  for (i = 0; i < SKIPLIST_MAX_LEVEL; i++) {
+    sl->head->links[i].next = NULL;
+    sl->head->links[i].span = 0;
+  }
+  sl->level = 1;
+  sl->size = 0;
+}
+size_t skiplist_size(const skiplist_t* sl) {
+  if (!sl) return 0;
+  return sl->size;
+}
+int skiplist_empty(const skiplist_t* sl) { return skiplist_size(sl) == 0; }
@@ -0,0 +1,226 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "container/thread_pool.h"
+
+// Tasks [lo,hi) still to be run by a worker, or stolen from it
+typedef struct thread_pool_share_t {
+  pthread_mutex_t lock;
+  size_t lo;
+  size_t hi;
+} thread_pool_share_t;
+
+typedef struct thread_pool_worker_t {
+  thread_pool_t* pool;
+  size_t id;
+  pthread_t thread;
+} thread_pool_worker_t;
+
+struct thread_pool_t {
+  pthread_mutex_t run_lock;  // Serializes thread_pool_run
+  pthread_mutex_t lock;      // Protects the fields below
+  pthread_cond_t wake;       // Signaled when a job is posted or the pool stops
+  pthread_cond_t done;       // Signaled when the current job is over
+  uint64_t generation;       // Incremented for every job
+  size_t pending;            // Tasks of the current job not yet completed
+  size_t active;             // Workers still looking for tasks of the current job
+  int stop;
+  void (*fn)(void* arg, size_t task);
+  void* arg;
+  size_t threads;
+  thread_pool_worker_t* workers;
+  thread_pool_share_t* shares;
+};
+////////////////////////////////////////////////////////////////////////////
+// Private functions
+////////////////////////////////////////////////////////////////////////////
+static int thread_pool_take(thread_pool_t* pool, size_t id, size_t* task);
+static int thread_pool_steal(thread_pool_t* pool, size_t id);
+static void* thread_pool_main(void* arg);
+// Take the next task of worker 'id'
+static int thread_pool_take(thread_pool_t* pool, size_t id, size_t* task) {
+  thread_pool_share_t* share = &pool->shares[id];
+  int ok = 0;
+  pthread_mutex_lock(&share->lock);
+  if (share->lo < share->hi) {
+    *task = share->lo++;
+    ok = 1;
+  }
+  pthread_mutex_unlock(&share->lock);
+  return ok;
+}
+// Move the upper half of the largest share of the other workers to worker 'id'
+static int thread_pool_steal(thread_pool_t* pool, size_t id) {
+  size_t victim = id, most = 0, i = 0;
+  for (i = 1; i < pool->threads; i++) {
+    size_t other = (id + i) % pool->threads;
+    thread_pool_share_t* share = &pool->shares[other];
+    pthread_mutex_lock(&share->lock);
+    size_t left = share->hi - share->lo;
+    pthread_mutex_unlock(&share->lock);
+    if (left > most) {
+      most = left;
+      victim = other;
+    }
+  }
+  if (victim == id) return 0;
+
+  thread_pool_share_t* share = &pool->shares[victim];
+  size_t lo = 0, hi = 0;
+  pthread_mutex_lock(&share->lock);
+  if (share->lo < share->hi) {
+    hi = share->hi;
+    lo = share->hi - (share->hi - share->lo + 1) / 2;
+    share->hi = lo;
+  }
+  pthread_mutex_unlock(&share->lock);
+  if (lo == hi) return 1;  // Raced with the owner, look again
+
+  share = &pool->shares[id];
+  pthread_mutex_lock(&share->lock);
+  share->lo = lo;
+  share->hi = hi;
+  pthread_mutex_unlock(&share->lock);
+  return 1;
+}
+static void* thread_pool_main(void* arg) {
+  thread_pool_worker_t* worker = (thread_pool_worker_t*)arg;
+  thread_pool_t* pool = worker->pool;
+  uint64_t generation = 0;
+
+  pthread_mutex_lock(&pool->lock);
+  for (;;) {
+    while (!pool->stop && pool->generation == generation) pthread_cond_wait(&pool->wake, &pool->lock);
+    if (pool->stop) break;
+    generation = pool->generation;
+    void (*fn)(void* arg, size_t task) = pool->fn;
+    void* fn_arg = pool->arg;
+    pool->active++;
+    pthread_mutex_unlock(&pool->lock);
+
+    size_t completed = 0, task = 0;
+    for (;;) {
+      if (thread_pool_take(pool, worker->id, &task)) {
+        fn(fn_arg, task);
+        completed++;
+      } else if (!thread_pool_steal(pool, worker->id)) {
+        break;
+      }
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->pending -= completed;
+    if (!--pool->active) pthread_cond_signal(&pool->done);
+  }
+  pthread_mutex_unlock(&pool->lock);
+  return NULL;
+}
+////////////////////////////////////////////////////////////////////////////
+// Public functions
+////////////////////////////////////////////////////////////////////////////
+thread_pool_t* thread_pool_create(size_t threads) {
+  if (!threads) return NULL;
+
+  thread_pool_t* pool = (thread_pool_t*)calloc(1, sizeof(thread_pool_t));
+  if (!pool) return NULL;
+  pool->workers = (thread_pool_worker_t*)calloc(threads, sizeof(thread_pool_worker_t));
+  pool->shares = (thread_pool_share_t*)calloc(threads, sizeof(thread_pool_share_t));
+  if (!pool->workers || !pool->shares) {
+    free(pool->workers);
+    free(pool->shares);
+    free(pool);
+    return NULL;
+  }
+  pthread_mutex_init(&pool->run_lock, NULL);
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->wake, NULL);
+  pthread_cond_init(&pool->done, NULL);
+  size_t i = 0;
+  for (i = 0; i < threads; i++) pthread_mutex_init(&pool->shares[i].lock, NULL);
+  for (i = 0; i < threads; i++) {
+    thread_pool_worker_t* worker = &pool->workers[i];
+    worker->pool = pool;
+    worker->id = i;
+    if (pthread_create(&worker->thread, NULL, thread_pool_main, worker)) {
+      // Workers started so far are stopped by destroy
+      size_t j = 0;
+      for (j = i; j < threads; j++) pthread_mutex_destroy(&pool->shares[j].lock);
+      thread_pool_destroy(pool);
+      return NULL;
+    }
+    pool->threads++;
+  }
+  return pool;
+}
+void thread_pool_destroy(thread_pool_t* pool) {
+  if (!pool) return;
+
+  pthread_mutex_lock(&pool->lock);
+  pool->stop = 1;
+  pthread_cond_broadcast(&pool->wake);
+  pthread_mutex_unlock(&pool->lock);
+  size_t i = 0;
+  for (i = 0; i < pool->threads; i++) pthread_join(pool->workers[i].thread, NULL);
+  for (i = 0; i < pool->threads; i++) pthread_mutex_destroy(&pool->shares[i].lock);
+  pthread_cond_destroy(&pool->done);
+  pthread_cond_destroy(&pool->wake);
+  pthread_mutex_destroy(&pool->lock);
+  pthread_mutex_destroy(&pool->run_lock);
+  free(pool->workers);
+  free(pool->shares);
+  free(pool);
+}
+size_t thread_pool_size(const thread_pool_t* pool) {
+  if (!pool) return 0;
+  return pool->threads;
+}
+int thread_pool_run(thread_pool_t* pool, void (*fn)(void* arg, size_t task), void* arg, size_t count) {
+  if (!pool || !fn) return -1;
+  if (!count) return 0;
+
+  pthread_mutex_lock(&pool->run_lock);
+  pthread_mutex_lock(&pool->lock);
+  // A worker that woke up late for the previous job may still be looking at the shares with its callback
+  while (pool->active) pthread_cond_wait(&pool->done, &pool->lock);
+  // Contiguous shares, the first workers get one task more
+  size_t i = 0, lo = 0;
+  for (i = 0; i < pool->threads; i++) {
+    size_t share = count / pool->threads + (i < count % pool->threads ? 1 : 0);
+    pthread_mutex_lock(&pool->shares[i].lock);
+    pool->shares[i].lo = lo;
+    pool->shares[i].hi = lo + share;
+    pthread_mutex_unlock(&pool->shares[i].lock);
+    lo += share;
+  }
+  pool->fn = fn;
+  pool->arg = arg;
+  pool->pending = count;
+  pool->generation++;
+  pthread_cond_broadcast(&pool->wake);
+  // The job is over once all tasks completed and no worker can pick up a task with its callback anymore
+  while (pool->pending || pool->active) pthread_cond_wait(&pool->done, &pool->lock);
+  pthread_mutex_unlock(&pool->lock);
+  pthread_mutex_unlock(&pool->run_lock);
+  return 0;
+}
@@ -0,0 +1,285 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <stdlib.h>
+#include <string.h>  // for 'memset'
+
+#include "container/ulist.h"
+
+// Nodes start on a cache line boundary
+#define ULIST_NODE_ALIGN 64
+#define ULIST_NODE_SIZE ((sizeof(ulist_node_t) + ULIST_NODE_ALIGN - 1) & ~(size_t)(ULIST_NODE_ALIGN - 1))
+////////////////////////////////////////////////////////////////////////////
+// Private functions
+////////////////////////////////////////////////////////////////////////////
+static ulist_node_t* ulist_node_alloc(uint32_t pos);
+static void ulist_node_unlink(ulist_t* lst, ulist_node_t* node);
+static void ulist_delete_data(void* data, void (*deleter)(void* data));
+// Allocate an empty node whose elements start at 'pos'
+static ulist_node_t* ulist_node_alloc(uint32_t pos) {
+  ulist_node_t* node = (ulist_node_t*)aligned_alloc(ULIST_NODE_ALIGN, ULIST_NODE_SIZE);
+  if (!node) return NULL;
+  node->next = node->prev = NULL;
+  node->begin = node->end = pos;
+  return node;
+}
+// Unlink and free a node
+static void ulist_node_unlink(ulist_t* lst, ulist_node_t* node) {
+  if (node->prev)
+    (node->prev)->next = node->next;
+  else
+    lst->head = node->next;
+  if (node->next)
+    (node->next)->prev = node->prev;
+  else
+    lst->tail = node->prev;
+  free(node);
+}
+// Destroy element payload, by default the memory is just freed
+static void ulist_delete_data(void* data, void (*deleter)(void* data)) {
+  if (deleter)
+    deleter(data);
+  else
+    free(data);
+}
+////////////////////////////////////////////////////////////////////////////
+// Public functions
+////////////////////////////////////////////////////////////////////////////
+void ulist_init(ulist_t* lst) {
+  if (!lst) return;
+  memset(lst, 0, sizeof(*lst));
+}
+int ulist_push_back(ulist_t* lst, void* data) {
+  if (!lst || !data) return -1;
+
+  ulist_node_t* node = lst->tail;
+  if (!node || node->end == ULIST_NODE_CAPACITY) {
+    node = ulist_node_alloc(0);
+    if (!node) return -1;
+    node->prev = lst->tail;
+    if (lst->tail)
+      (lst->tail)->next = node;
+    else
+      lst->head = node;
+    lst->tail = node;
+  }
+  node->data[node->end++] = data;
+  lst->size++;
+  return 0;
+}
+int ulist_push_front(ulist_t* lst, void* data) {
+  if (!lst || !data) return -1;
+
+  ulist_node_t* node = lst->head;
+  if (!node || node->begin == 0) {
+    // A new front node is filled from its end, so further pushes at the front need no shifting
+    node = ulist_node_alloc(ULIST_NODE_CAPACITY);
+    if (!node) return -1;
+    node->next = lst->head;
+    if (lst->head)
+      (lst->head)->prev = node;
+    else
+      lst->tail = node;
+    lst->head = node;
+  }
+  node->data[--node->begin] = data;
+  lst->size++;
+  return 0;
+}
+void ulist_pop_front(ulist_t* lst, void (*deleter)(void* data)) {
+  if (!lst || !lst->head) return;
+
+  ulist_node_t* node = lst->head;
+  ulist_delete_data(node->data[node->begin++], deleter);
+  lst->size--;
+  if (node->begin == node->end) ulist_node_unlink(lst, node);
+}
+void ulist_pop_back(ulist_t* lst, void (*deleter)(void* data)) {
+  if (!lst || !lst->tail) return;
+
+  ulist_node_t* node = lst->tail;
+  ulist_delete_data(node->data[--node->end], deleter);
+  lst->size--;
+  if (node->begin == node->end) ulist_node_unlink(lst, node);
+}
+void* ulist_front(const ulist_t* lst) {
+  if (!lst || !lst->head) return NULL;
+  return lst->head->data[lst->head->begin];
+}
+void* ulist_back(const ulist_t* lst) {
+  if (!lst || !lst->tail) return NULL;
+  return lst->tail->data[lst->tail->end - 1];
+}
+void* ulist_at(const ulist_t* lst, size_t pos) {
+  if (!lst || pos >= lst->size) return NULL;
+
+  const ulist_node_t* node = lst->head;
+  while (node) {
+    size_t count = node->end - node->begin;
+    if (pos < count) return node->data[node->begin + pos];
+    pos -= count;
+    // Set next
+    node = node->next;
+  }
+  return NULL;
+}
+size_t ulist_size(const ulist_t* lst) {
+  if (!lst) return 0;
+  return lst->size;
+}
+int ulist_empty(const ulist_t* lst) {
+  if (!lst || !lst->size) return 1;
+  return 0;
+}
+void ulist_clear(ulist_t* lst, void (*deleter)(void* data)) {
+  if (!lst) return;
+
+  ulist_node_t* node = lst->head;
+  while (node) {
+    ulist_node_t* tmp = node;
+    // Set next
+    node = node->next;
+    uint32_t i = 0;
+    for (i = tmp->begin; i < tmp->end; i++) ulist_delete_data(tmp->data[i], deleter);
+    free(tmp);
+  }
+  memset(lst, 0, sizeof(*lst));
+}
+////////////////////////////////////////////////////////////////////////////
+// Algorithms
+////////////////////////////////////////////////////////////////////////////
+int ulist_for_each(ulist_t* lst, int (*fn)(void* data)) {
+  if (!lst || !fn) return 0;
+
+  const ulist_node_t* node = lst->head;
+  while (node) {
+    uint32_t i = 0;
+    for (i = node->begin; i < node->end; i++) fn(node->data[i]);
+    // Set next
+    node = node->next;
+  }
+  return 0;
+}
+int ulist_any_of(ulist_t* lst, int (*fn)(void* data)) {
+  if (!lst || !fn) return 0;
+
+  const ulist_node_t* node = lst->head;
+  while (node) {
+    uint32_t i = 0;
+    for (i = node->begin; i < node->end; i++)
+      if (1 == fn(node->data[i])) return 1;
+    // Set next
+    node = node->next;
+  }
+  return 0;
+}
+int ulist_all_of(ulist_t* lst, int (*fn)(void* data)) {
+  if (!lst || !fn) return 1;
+
+  const ulist_node_t* node = lst->head;
+  while (node) {
+    uint32_t i = 0;
+    for (i = node->begin; i < node->end; i++)
+      if (!fn(node->data[i])) return 0;
+    // Set next
+    node = node->next;
+  }
+  return 1;
+}
+int ulist_none_of(ulist_t* lst, int (*fn)(void* data)) {
+  if (!lst || !fn) return 1;
+
+  const ulist_node_t* node = lst->head;
+  while (node) {
+    uint32_t i = 0;
+    for (i = node->begin; i < node->end; i++)
+      if (1 == fn(node->data[i])) return 0;
+    // Set next
+    node = node->next;
+  }
+  return 1;
+}
+int ulist_count(const ulist_t* lst, const void* value, int (*predicate)(const void* data1, const void* data2)) {
+  if (!predicate || !lst) return -1;
+
+  int count = 0;
+  const ulist_node_t* node = lst->head;
+  while (node) {
+    uint32_t i = 0;
+    for (i = node->begin; i < node->end; i++)
+      if (0 == predicate(node->data[i], value)) count++;
+    // Set next
+    node = node->next;
+  }
+  return count;
+}
+void* ulist_find(const ulist_t* lst, const void* value, int (*predicate)(const void* data1, const void* data2)) {
+  if (!predicate || !lst) return NULL;
+
+  const ulist_node_t* node = lst->head;
+  while (node) {
+    uint32_t i = 0;
+    for (i = node->begin; i < node->end; i++)
+      if (0 == predicate(node->data[i], value)) return node->data[i];
+    // Set next
+    node = node->next;
+  }
+  return NULL;
+}
+int ulist_erase_if(ulist_t* lst, const void* value, int (*predicate)(const void* data1, const void* data2),
+                   void (*deleter)(void* data)) {
+  if (!predicate || !lst) return -1;
+  if (!lst->head) return 0;
+
+  int count = 0;
+  // Kept elements are written back behind the read position, packing the nodes as they go
+  ulist_node_t* wnode = lst->head;
+  uint32_t wpos = wnode->begin;
+  ulist_node_t* node = lst->head;
+  while (node) {
+    uint32_t begin = node->begin;
+    uint32_t end = node->end;
+    uint32_t i = 0;
+    for (i = begin; i < end; i++) {
+      void* data = node->data[i];
+      if (0 == predicate(data, value)) {
+        ulist_delete_data(data, deleter);
+        count++;
+        continue;
+      }
+      if (wpos == ULIST_NODE_CAPACITY) {
+        wnode->end = wpos;
+        wnode = wnode->next;
+        wnode->begin = 0;
+        wpos = 0;
+      }
+      wnode->data[wpos++] = data;
+    }
+    // Set next
+    node = node->next;
+  }
+  wnode->end = wpos;
+  // Free the nodes left behind the last written one
+  while (lst->tail != wnode) ulist_node_unlink(lst, lst->tail);
+  if (wnode->begin == wnode->end) ulist_node_unlink(lst, wnode);
+  lst->size -= (size_t)count;
+  return count;
+}
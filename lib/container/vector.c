@@ -0,0 +1,213 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+
+#include "container/vector.h"
+
+////////////////////////////////////////////////////////////////////////////
+// Private functions
+////////////////////////////////////////////////////////////////////////////
+static uint8_t* vector_elem(const vector_t* vec, size_t pos);
+static int vector_grow(vector_t* vec);
+static size_t vector_index_of(const vector_t* vec, const void* elem);
+static uint8_t* vector_elem(const vector_t* vec, size_t pos) { return (uint8_t*)vec->data + pos * vec->elem_sz; }
+// Make room for one more element, doubling the capacity
+static int vector_grow(vector_t* vec) {
+  if (vec->size < vec->capacity) return 0;
+  return vector_reserve(vec, vec->capacity ? vec->capacity * 2 : 8);
+}
+// Position of 'elem' when it points at an element of the vector, which growing or shifting would move, or SIZE_MAX
+static size_t vector_index_of(const vector_t* vec, const void* elem) {
+  uintptr_t begin = (uintptr_t)vec->data, addr = (uintptr_t)elem;
+  if (!vec->size || addr < begin || addr >= begin + vec->size * vec->elem_sz) return SIZE_MAX;
+  return (addr - begin) / vec->elem_sz;
+}
+////////////////////////////////////////////////////////////////////////////
+// Public functions
+////////////////////////////////////////////////////////////////////////////
+void vector_init(vector_t* vec, size_t elem_sz) {
+  if (!vec) return;
+  vec->data = NULL;
+  vec->size = vec->capacity = 0;
+  vec->elem_sz = elem_sz;
+}
+void vector_destroy(vector_t* vec, void (*deleter)(void* data)) {
+  if (!vec) return;
+  vector_clear(vec, deleter);
+  free(vec->data);
+  vec->data = NULL;
+  vec->capacity = 0;
+}
+int vector_reserve(vector_t* vec, size_t capacity) {
+  if (!vec || !vec->elem_sz) return -1;
+  if (capacity <= vec->capacity) return 0;
+  if (capacity > SIZE_MAX / vec->elem_sz) return -1;
+
+  void* data = realloc(vec->data, capacity * vec->elem_sz);
+  if (!data) return -1;
+  vec->data = data;
+  vec->capacity = capacity;
+  return 0;
+}
+void* vector_push_back(vector_t* vec, const void* elem) {
+  if (!vec || !elem) return NULL;
+  size_t src = vector_index_of(vec, elem);
+  if (vector_grow(vec)) return NULL;
+
+  if (src != SIZE_MAX) elem = vector_elem(vec, src);
+  uint8_t* dst = vector_elem(vec, vec->size++);
+  memcpy(dst, elem, vec->elem_sz);
+  return dst;
+}
+void vector_pop_back(vector_t* vec, void (*deleter)(void* data)) {
+  if (!vec || !vec->size) return;
+
+  vec->size--;
+  if (deleter) deleter(vector_elem(vec, vec->size));
+}
+void* vector_insert(vector_t* vec, size_t pos, const void* elem) {
+  if (!vec || !elem || pos > vec->size) return NULL;
+  size_t src = vector_index_of(vec, elem);
+  if (vector_grow(vec)) return NULL;
+
+  uint8_t* dst = vector_elem(vec, pos);
+  memmove(dst + vec->elem_sz, dst, (vec->size - pos) * vec->elem_sz);
+  // An element of the vector is read where the move left it
+  if (src != SIZE_MAX) elem = vector_elem(vec, src < pos ? src : src + 1);
+  memcpy(dst, elem, vec->elem_sz);
+  vec->size++;
+  return dst;
+}
+void vector_erase(vector_t* vec, size_t pos, void (*deleter)(void* data)) {
+  if (!vec || pos >= vec->size) return;
+
+  uint8_t* dst = vector_elem(vec, pos);
+  if (deleter) deleter(dst);
+  memmove(dst, dst + vec->elem_sz, (vec->size - pos - 1) * vec->elem_sz);
+  vec->size--;
+}
+void* vector_at(const vector_t* vec, size_t pos) {
+  if (!vec || pos >= vec->size) return NULL;
+  return vector_elem(vec, pos);
+}
+void* vector_front(const vector_t* vec) { return vector_at(vec, 0); }
+void* vector_back(const vector_t* vec) {
+  if (!vec || !vec->size) return NULL;
+  return vector_elem(vec, vec->size - 1);
+}
+size_t vector_size(const vector_t* vec) {
+  if (!vec) return 0;
+  return vec->size;
+}
+int vector_empty(const vector_t* vec) { return vector_size(vec) == 0; }
+void vector_clear(vector_t* vec, void (*deleter)(void* data)) {
+  if (!vec) return;
+
+  size_t i = 0;
+  if (deleter)
+    for (i = 0; i < vec->size; i++) deleter(vector_elem(vec, i));
+  vec->size = 0;
+}
+int vector_for_each(vector_t* vec, int (*fn)(void* data)) {
+  if (!vec || !fn) return 0;
+
+  size_t i = 0;
+  for (i = 0; i < vec->size; i++) fn(vector_elem(vec, i));
+  return 0;
+}
+int vector_for_each_ctx(vector_t* vec, int (*fn)(void* data, void* ctx), void* ctx) {
+  if (!vec || !fn) return 0;
+
+  size_t i = 0;
+  for (i = 0; i < vec->size; i++) fn(vector_elem(vec, i), ctx);
+  return 0;
+}
+int vector_any_of(vector_t* vec, int (*fn)(void* data)) {
+  if (!vec || !fn) return 0;
+
+  size_t i = 0;
+  for (i = 0; i < vec->size; i++)
+    if (1 == fn(vector_elem(vec, i))) return 1;
+  return 0;
+}
+int vector_all_of(vector_t* vec, int (*fn)(void* data)) {
+  if (!vec || !fn) return 1;
+
+  size_t i = 0;
+  for (i = 0; i < vec->size; i++)
+    if (!fn(vector_elem(vec, i))) return 0;
+  return 1;
+}
+int vector_none_of(vector_t* vec, int (*fn)(void* data)) {
+  if (!vec || !fn) return 1;
+
+  size_t i = 0;
+  for (i = 0; i < vec->size; i++)
+    if (1 == fn(vector_elem(vec, i))) return 0;
+  return 1;
+}
+int vector_count(const vector_t* vec, const void* value, int (*predicate)(const void* data1, const void* data2)) {
+  if (!vec || !predicate) return -1;
+
+  int count = 0;
+  size_t i = 0;
+  for (i = 0; i < vec->size; i++)
+    if (0 == predicate(vector_elem(vec, i), value)) count++;
+  return count;
+}
+void* vector_find(vector_t* vec, const void* value, int (*predicate)(const void* data1, const void* data2)) {
+  return (void*)vector_cfind(vec, value, predicate);
+}
+const void* vector_cfind(const vector_t* vec, const void* value,
+                         int (*predicate)(const void* data1, const void* data2)) {
+  if (!vec || !predicate) return NULL;
+
+  size_t i = 0;
+  for (i = 0; i < vec->size; i++)
+    if (0 == predicate(vector_elem(vec, i), value)) return vector_elem(vec, i);
+  return NULL;
+}
+int vector_erase_if(vector_t* vec, const void* value, int (*predicate)(const void* data1, const void* data2),
+                    void (*deleter)(void* data)) {
+  if (!vec || !predicate) return -1;
+
+  // Kept elements slide down over the removed ones in one pass
+  size_t i = 0, kept = 0;
+  for (i = 0; i < vec->size; i++) {
+    uint8_t* cur = vector_elem(vec, i);
+    if (0 == predicate(cur, value)) {
+      if (deleter) deleter(cur);
+      continue;
+    }
+    if (kept != i) memcpy(vector_elem(vec, kept), cur, vec->elem_sz);
+    kept++;
+  }
+  int count = (int)(vec->size - kept);
+  vec->size = kept;
+  return count;
+}
+int vector_sort(vector_t* vec, int (*compare)(const void* data1, const void* data2)) {
+  if (!vec || !compare) return -1;
+  if (vec->size > 1) qsort(vec->data, vec->size, vec->elem_sz, compare);
+  return 0;
+}
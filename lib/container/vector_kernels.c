@@ -0,0 +1,331 @@
+/*******************************************************************************
+** Copyright (c) 2012 - 2022 v.arteev
+
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+
+** The above copyright notice and this permission notice shall be included in all
+** copies or substantial portions of the Software.
+
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+** SOFTWARE.
+*******************************************************************************/
+#include "container/vector.h"
+
+// Typed kernels for vector.h. Each kernel has a scalar version and, on x86, SSE2 and AVX2 versions compiled through
+// target attributes, so the library itself needs no -m flags; the widest one the CPU supports is picked at run time.
+#if defined(__x86_64__) || defined(__i386__)
+#define VECTOR_X86 1
+#include <immintrin.h>
+#else
+#define VECTOR_X86 0
+#endif
+
+#define VECTOR_AVX2 __attribute__((target("avx2,popcnt")))
+#define VECTOR_SSE2 __attribute__((target("sse2")))
+
+////////////////////////////////////////////////////////////////////////////
+// Scalar kernels: find returns the index of the first match or 'n', minmax needs n > 0
+////////////////////////////////////////////////////////////////////////////
+#define VECTOR_SCALAR_KERNELS(suffix, type)                                                           \
+  static size_t vector_find_##suffix##_scalar(const type* p, size_t n, type value) {                   \
+    size_t i = 0;                                                                                      \
+    for (i = 0; i < n; i++)                                                                            \
+      if (p[i] == value) return i;                                                                     \
+    return n;                                                                                          \
+  }                                                                                                    \
+  static size_t vector_count_##suffix##_scalar(const type* p, size_t n, type value) {                  \
+    size_t i = 0, count = 0;                                                                           \
+    for (i = 0; i < n; i++) count += p[i] == value;                                                    \
+    return count;                                                                                      \
+  }                                                                                                    \
+  static void vector_minmax_##suffix##_scalar(const type* p, size_t n, type* min, type* max) {         \
+    size_t i = 0;                                                                                      \
+    for (i = 0; i < n; i++) {                                                                          \
+      if (p[i] < *min) *min = p[i];                                                                    \
+      if (p[i] > *max) *max = p[i];                                                                    \
+    }                                                                                                  \
+  }
+
+VECTOR_SCALAR_KERNELS(i32, int32_t)
+VECTOR_SCALAR_KERNELS(i64, int64_t)
+VECTOR_SCALAR_KERNELS(f32, float)
+VECTOR_SCALAR_KERNELS(f64, double)
+
+#if VECTOR_X86
+////////////////////////////////////////////////////////////////////////////
+// AVX2 kernels
+////////////////////////////////////////////////////////////////////////////
+// Match masks: one bit per element
+VECTOR_AVX2 static int vector_eq_i32_avx2(const int32_t* p, __m256i v) {
+  __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)p), v);
+  return _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+}
+VECTOR_AVX2 static int vector_eq_i64_avx2(const int64_t* p, __m256i v) {
+  __m256i eq = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)p), v);
+  return _mm256_movemask_pd(_mm256_castsi256_pd(eq));
+}
+VECTOR_AVX2 static int vector_eq_f32_avx2(const float* p, __m256 v) {
+  return _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p), v, _CMP_EQ_OQ));
+}
+VECTOR_AVX2 static int vector_eq_f64_avx2(const double* p, __m256d v) {
+  return _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(p), v, _CMP_EQ_OQ));
+}
+
+#define VECTOR_AVX2_FIND_COUNT(suffix, type, vtype, set1, lanes)                                       \
+  VECTOR_AVX2 static size_t vector_find_##suffix##_avx2(const type* p, size_t n, type value) {         \
+    vtype v = set1(value);                                                                             \
+    size_t i = 0;                                                                                      \
+    for (i = 0; i + (lanes) <= n; i += (lanes)) {                                                      \
+      int mask = vector_eq_##suffix##_avx2(p + i, v);                                                  \
+      if (mask) return i + (size_t)__builtin_ctz((unsigned)mask);                                      \
+    }                                                                                                  \
+    return i + vector_find_##suffix##_scalar(p + i, n - i, value);                                     \
+  }                                                                                                    \
+  VECTOR_AVX2 static size_t vector_count_##suffix##_avx2(const type* p, size_t n, type value) {        \
+    vtype v = set1(value);                                                                             \
+    size_t i = 0, count = 0;                                                                           \
+    for (i = 0; i + 2 * (lanes) <= n; i += 2 * (lanes)) {                                              \
+      count += (size_t)__builtin_popcount((unsigned)vector_eq_##suffix##_avx2(p + i, v));              \
+      count += (size_t)__builtin_popcount((unsigned)vector_eq_##suffix##_avx2(p + i + (lanes), v));    \
+    }                                                                                                  \
+    return count + vector_count_##suffix##_scalar(p + i, n - i, value);                                \
+  }
+
+VECTOR_AVX2_FIND_COUNT(i32, int32_t, __m256i, _mm256_set1_epi32, 8)
+VECTOR_AVX2_FIND_COUNT(i64, int64_t, __m256i, _mm256_set1_epi64x, 4)
+VECTOR_AVX2_FIND_COUNT(f32, float, __m256, _mm256_set1_ps, 8)
+VECTOR_AVX2_FIND_COUNT(f64, double, __m256d, _mm256_set1_pd, 4)
+
+VECTOR_AVX2 static void vector_minmax_i32_avx2(const int32_t* p, size_t n, int32_t* min, int32_t* max) {
+  size_t i = 0;
+  if (n >= 8) {
+    __m256i vmin = _mm256_loadu_si256((const __m256i*)p);
+    __m256i vmax = vmin;
+    for (i = 8; i + 8 <= n; i += 8) {
+      __m256i x = _mm256_loadu_si256((const __m256i*)(p + i));
+      vmin = _mm256_min_epi32(vmin, x);
+      vmax = _mm256_max_epi32(vmax, x);
+    }
+    int32_t lanes[8];
+    _mm256_storeu_si256((__m256i*)lanes, vmin);
+    vector_minmax_i32_scalar(lanes, 8, min, max);
+    _mm256_storeu_si256((__m256i*)lanes, vmax);
+    vector_minmax_i32_scalar(lanes, 8, min, max);
+  }
+  vector_minmax_i32_scalar(p + i, n - i, min, max);
+}
+VECTOR_AVX2 static void vector_minmax_i64_avx2(const int64_t* p, size_t n, int64_t* min, int64_t* max) {
+  size_t i = 0;
+  if (n >= 4) {
+    __m256i vmin = _mm256_loadu_si256((const __m256i*)p);
+    __m256i vmax = vmin;
+    for (i = 4; i + 4 <= n; i += 4) {
+      __m256i x = _mm256_loadu_si256((const __m256i*)(p + i));
+      // No 64-bit min/max before AVX-512, select through a compare
+      vmin = _mm256_blendv_epi8(vmin, x, _mm256_cmpgt_epi64(vmin, x));
+      vmax = _mm256_blendv_epi8(vmax, x, _mm256_cmpgt_epi64(x, vmax));
+    }
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, vmin);
+    vector_minmax_i64_scalar(lanes, 4, min, max);
+    _mm256_storeu_si256((__m256i*)lanes, vmax);
+    vector_minmax_i64_scalar(lanes, 4, min, max);
+  }
+  vector_minmax_i64_scalar(p + i, n - i, min, max);
+}
+VECTOR_AVX2 static void vector_minmax_f32_avx2(const float* p, size_t n, float* min, float* max) {
+  // Accumulators start from the running result, and NaN is the first operand of min/max so its lane keeps the
+  // accumulator: NaN elements are skipped as by the scalar kernel
+  __m256 vmin = _mm256_set1_ps(*min);
+  __m256 vmax = _mm256_set1_ps(*max);
+  size_t i = 0;
+  for (i = 0; i + 8 <= n; i += 8) {
+    __m256 x = _mm256_loadu_ps(p + i);
+    vmin = _mm256_min_ps(x, vmin);
+    vmax = _mm256_max_ps(x, vmax);
+  }
+  float lanes[8];
+  _mm256_storeu_ps(lanes, vmin);
+  vector_minmax_f32_scalar(lanes, 8, min, max);
+  _mm256_storeu_ps(lanes, vmax);
+  vector_minmax_f32_scalar(lanes, 8, min, max);
+  vector_minmax_f32_scalar(p + i, n - i, min, max);
+}
+VECTOR_AVX2 static void vector_minmax_f64_avx2(const double* p, size_t n, double* min, double* max) {
+  __m256d vmin = _mm256_set1_pd(*min);
+  __m256d vmax = _mm256_set1_pd(*max);
+  size_t i = 0;
+  for (i = 0; i + 4 <= n; i += 4) {
+    __m256d x = _mm256_loadu_pd(p + i);
+    vmin = _mm256_min_pd(x, vmin);
+    vmax = _mm256_max_pd(x, vmax);
+  }
+  double lanes[4];
+  _mm256_storeu_pd(lanes, vmin);
+  vector_minmax_f64_scalar(lanes, 4, min, max);
+  _mm256_storeu_pd(lanes, vmax);
+  vector_minmax_f64_scalar(lanes, 4, min, max);
+  vector_minmax_f64_scalar(p + i, n - i, min, max);
+}
+////////////////////////////////////////////////////////////////////////////
+// SSE2 kernels
+////////////////////////////////////////////////////////////////////////////
+VECTOR_SSE2 static int vector_eq_i32_sse2(const int32_t* p, __m128i v) {
+  __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)p), v);
+  return _mm_movemask_ps(_mm_castsi128_ps(eq));
+}
+VECTOR_SSE2 static int vector_eq_i64_sse2(const int64_t* p, __m128i v) {
+  // No 64-bit compare in SSE2: both 32-bit halves must match
+  __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)p), v);
+  eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_movemask_pd(_mm_castsi128_pd(eq));
+}
+VECTOR_SSE2 static int vector_eq_f32_sse2(const float* p, __m128 v) {
+  return _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(p), v));
+}
+VECTOR_SSE2 static int vector_eq_f64_sse2(const double* p, __m128d v) {
+  return _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(p), v));
+}
+
+#define VECTOR_SSE2_FIND_COUNT(suffix, type, vtype, set1, lanes)                                       \
+  VECTOR_SSE2 static size_t vector_find_##suffix##_sse2(const type* p, size_t n, type value) {         \
+    vtype v = set1(value);                                                                             \
+    size_t i = 0;                                                                                      \
+    for (i = 0; i + (lanes) <= n; i += (lanes)) {                                                      \
+      int mask = vector_eq_##suffix##_sse2(p + i, v);                                                  \
+      if (mask) return i + (size_t)__builtin_ctz((unsigned)mask);                                      \
+    }                                                                                                  \
+    return i + vector_find_##suffix##_scalar(p + i, n - i, value);                                     \
+  }                                                                                                    \
+  VECTOR_SSE2 static size_t vector_count_##suffix##_sse2(const type* p, size_t n, type value) {        \
+    vtype v = set1(value);                                                                             \
+    size_t i = 0, count = 0;                                                                           \
+    for (i = 0; i + (lanes) <= n; i += (lanes))                                                        \
+      count += (size_t)__builtin_popcount((unsigned)vector_eq_##suffix##_sse2(p + i, v));              \
+    return count + vector_count_##suffix##_scalar(p + i, n - i, value);                                \
+  }
+
+VECTOR_SSE2_FIND_COUNT(i32, int32_t, __m128i, _mm_set1_epi32, 4)
+VECTOR_SSE2_FIND_COUNT(i64, int64_t, __m128i, _mm_set1_epi64x, 2)
+VECTOR_SSE2_FIND_COUNT(f32, float, __m128, _mm_set1_ps, 4)
+VECTOR_SSE2_FIND_COUNT(f64, double, __m128d, _mm_set1_pd, 2)
+
+VECTOR_SSE2 static void vector_minmax_i32_sse2(const int32_t* p, size_t n, int32_t* min, int32_t* max) {
+  size_t i = 0;
+  if (n >= 4) {
+    __m128i vmin = _mm_loadu_si128((const __m128i*)p);
+    __m128i vmax = vmin;
+    for (i = 4; i + 4 <= n; i += 4) {
+      __m128i x = _mm_loadu_si128((const __m128i*)(p + i));
+      // No 32-bit min/max before SSE4.1, select through a compare
+      __m128i lt = _mm_cmpgt_epi32(vmin, x);
+      vmin = _mm_or_si128(_mm_and_si128(lt, x), _mm_andnot_si128(lt, vmin));
+      __m128i gt = _mm_cmpgt_epi32(x, vmax);
+      vmax = _mm_or_si128(_mm_and_si128(gt, x), _mm_andnot_si128(gt, vmax));
+    }
+    int32_t lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, vmin);
+    vector_minmax_i32_scalar(lanes, 4, min, max);
+    _mm_storeu_si128((__m128i*)lanes, vmax);
+    vector_minmax_i32_scalar(lanes, 4, min, max);
+  }
+  vector_minmax_i32_scalar(p + i, n - i, min, max);
+}
+// No 64-bit compare in SSE2
+static void vector_minmax_i64_sse2(const int64_t* p, size_t n, int64_t* min, int64_t* max) {
+  vector_minmax_i64_scalar(p, n, min, max);
+}
+// Floating point NaN handling as vector_minmax_f32_avx2
+VECTOR_SSE2 static void vector_minmax_f32_sse2(const float* p, size_t n, float* min, float* max) {
+  __m128 vmin = _mm_set1_ps(*min);
+  __m128 vmax = _mm_set1_ps(*max);
+  size_t i = 0;
+  for (i = 0; i + 4 <= n; i += 4) {
+    __m128 x = _mm_loadu_ps(p + i);
+    vmin = _mm_min_ps(x, vmin);
+    vmax = _mm_max_ps(x, vmax);
+  }
+  float lanes[4];
+  _mm_storeu_ps(lanes, vmin);
+  vector_minmax_f32_scalar(lanes, 4, min, max);
+  _mm_storeu_ps(lanes, vmax);
+  vector_minmax_f32_scalar(lanes, 4, min, max);
+  vector_minmax_f32_scalar(p + i, n - i, min, max);
+}
+VECTOR_SSE2 static void vector_minmax_f64_sse2(const double* p, size_t n, double* min, double* max) {
+  __m128d vmin = _mm_set1_pd(*min);
+  __m128d vmax = _mm_set1_pd(*max);
+  size_t i = 0;
+  for (i = 0; i + 2 <= n; i += 2) {
+    __m128d x = _mm_loadu_pd(p + i);
+    vmin = _mm_min_pd(x, vmin);
+    vmax = _mm_max_pd(x, vmax);
+  }
+  double lanes[2];
+  _mm_storeu_pd(lanes, vmin);
+  vector_minmax_f64_scalar(lanes, 2, min, max);
+  _mm_storeu_pd(lanes, vmax);
+  vector_minmax_f64_scalar(lanes, 2, min, max);
+  vector_minmax_f64_scalar(p + i, n - i, min, max);
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////
+// Dispatch
+////////////////////////////////////////////////////////////////////////////
+// Widest instruction set available: 2 for AVX2, 1 for SSE2, 0 for none
+static int vector_isa(void) {
+#if VECTOR_X86
+  if (__builtin_cpu_supports("avx2")) return 2;
+  if (__builtin_cpu_supports("sse2")) return 1;
+#endif
+  return 0;
+}
+
+#if VECTOR_X86
+#define VECTOR_DISPATCH(kernel, suffix, ...)                                        \
+  (vector_isa() == 2   ? vector_##kernel##_##suffix##_avx2(__VA_ARGS__)             \
+   : vector_isa() == 1 ? vector_##kernel##_##suffix##_sse2(__VA_ARGS__)             \
+                       : vector_##kernel##_##suffix##_scalar(__VA_ARGS__))
+#else
+#define VECTOR_DISPATCH(kernel, suffix, ...) vector_##kernel##_##suffix##_scalar(__VA_ARGS__)
+#endif
+
+#define VECTOR_TYPED_API(suffix, type)                                                                 \
+  type* vector_find_##suffix(const vector_t* vec, type value) {                                        \
+    if (!vec || vec->elem_sz != sizeof(type) || !vec->size) return NULL;                               \
+    const type* p = (const type*)vec->data;                                                            \
+    size_t i = VECTOR_DISPATCH(find, suffix, p, vec->size, value);                                     \
+    return i < vec->size ? (type*)p + i : NULL;                                                        \
+  }                                                                                                    \
+  size_t vector_count_##suffix(const vector_t* vec, type value) {                                      \
+    if (!vec || vec->elem_sz != sizeof(type) || !vec->size) return 0;                                  \
+    return VECTOR_DISPATCH(count, suffix, (const type*)vec->data, vec->size, value);                   \
+  }                                                                                                    \
+  int vector_min_##suffix(const vector_t* vec, type* min) {                                            \
+    if (!vec || !min || vec->elem_sz != sizeof(type) || !vec->size) return -1;                         \
+    type max = *min = *(const type*)vec->data;                                                         \
+    VECTOR_DISPATCH(minmax, suffix, (const type*)vec->data, vec->size, min, &max);                     \
+    return 0;                                                                                          \
+  }                                                                                                    \
+  int vector_max_##suffix(const vector_t* vec, type* max) {                                            \
+    if (!vec || !max || vec->elem_sz != sizeof(type) || !vec->size) return -1;                         \
+    type min = *max = *(const type*)vec->data;                                                         \
+    VECTOR_DISPATCH(minmax, suffix, (const type*)vec->data, vec->size, &min, max);                     \
+    return 0;                                                                                          \
+  }
+
+VECTOR_TYPED_API(i32, int32_t)
+VECTOR_TYPED_API(i64, int64_t)
+VECTOR_TYPED_API(f32, float)
+VECTOR_TYPED_API(f64, double)